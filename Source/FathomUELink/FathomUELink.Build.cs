@@ -22,11 +22,15 @@ public class FathomUELink : ModuleRules
 			"BlueprintGraph",
 			"ControlRig",
 			"ControlRigDeveloper",
+			"DeveloperSettings",
 			"Json",
 			"Projects",
 			"RigVMDeveloper",
+			"Slate",
+			"SlateCore",
 			"UMG",
 			"UMGEditor",
+			"UnrealEd",
 		});
 
 		if (Target.Platform == UnrealTargetPlatform.Win64)
@@ -0,0 +1,153 @@
+#include "Audit/AssetStubAuditor.h"
+
+#include "Audit/AuditFileUtils.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	/** Strip the Class'...' wrapper and quotes from an exported object path tag value. */
+	FString CleanObjectPathTag(const FString& TagValue)
+	{
+		FString Path = FPackageName::ExportTextPathToObjectPath(TagValue);
+		Path.TrimQuotesInline();
+		return Path;
+	}
+
+	/**
+	 * Pull the interface class paths out of a Blueprint's ImplementedInterfaces tag,
+	 * which holds an exported TArray<FBPInterfaceDescription>:
+	 * ((Interface=/Script/CoreUObject.Class'"/Script/Foo.Bar"',Graphs=(...)),...)
+	 */
+	void ParseInterfacesTag(const FString& TagValue, TArray<FString>& OutInterfaces)
+	{
+		static const FString Key = TEXT("Interface=");
+
+		int32 SearchFrom = 0;
+		while (true)
+		{
+			const int32 KeyPos = TagValue.Find(Key, ESearchCase::CaseSensitive, ESearchDir::FromStart, SearchFrom);
+			if (KeyPos == INDEX_NONE)
+			{
+				break;
+			}
+
+			const int32 Start = KeyPos + Key.Len();
+			int32 End = Start;
+			while (End < TagValue.Len() && TagValue[End] != TEXT(',') && TagValue[End] != TEXT(')'))
+			{
+				++End;
+			}
+
+			const FString InterfacePath = CleanObjectPathTag(TagValue.Mid(Start, End - Start));
+			if (!InterfacePath.IsEmpty() && InterfacePath != TEXT("None"))
+			{
+				OutInterfaces.AddUnique(InterfacePath);
+			}
+			SearchFrom = End;
+		}
+	}
+}
+
+FAssetStubAuditData FAssetStubAuditor::GatherData(const FAssetData& Asset, IAssetRegistry& AssetRegistry)
+{
+	FAssetStubAuditData Data;
+
+	Data.Name = Asset.AssetName.ToString();
+	Data.Path = Asset.GetObjectPathString();
+	Data.PackageName = Asset.PackageName.ToString();
+	Data.AssetClass = Asset.AssetClassPath.ToString();
+	Data.SourceFilePath = FAuditFileUtils::GetSourceFilePath(Data.PackageName);
+	Data.OutputPath = FAuditFileUtils::GetAuditOutputPath(Data.PackageName);
+
+	// Blueprint tags (written by UBlueprint::GetAssetRegistryTags, present without loading)
+	FString TagValue;
+	if (Asset.GetTagValue(FBlueprintTags::ParentClassPath, TagValue))
+	{
+		Data.ParentClass = CleanObjectPathTag(TagValue);
+	}
+	if (Asset.GetTagValue(FBlueprintTags::NativeParentClassPath, TagValue))
+	{
+		Data.NativeParentClass = CleanObjectPathTag(TagValue);
+	}
+	if (Asset.GetTagValue(FBlueprintTags::ImplementedInterfaces, TagValue))
+	{
+		ParseInterfacesTag(TagValue, Data.Interfaces);
+	}
+
+	// Package summary data cached by the registry
+	if (const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Asset.PackageName))
+	{
+		Data.DiskSize = PackageData->DiskSize;
+	}
+
+	TArray<FName> Dependencies;
+	AssetRegistry.GetDependencies(Asset.PackageName, Dependencies,
+		UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	for (const FName& Dependency : Dependencies)
+	{
+		FString DependencyName = Dependency.ToString();
+		if (!DependencyName.StartsWith(TEXT("/Script/")))
+		{
+			Data.Dependencies.Add(MoveTemp(DependencyName));
+		}
+	}
+	Data.Dependencies.Sort();
+
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(Asset.PackageName, Referencers,
+		UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	Data.ReferencerCount = Referencers.Num();
+
+	return Data;
+}
+
+FString FAssetStubAuditor::SerializeToMarkdown(const FAssetStubAuditData& Data)
+{
+	FString Result;
+	Result.Reserve(512);
+
+	// Header. No Hash line: a stub must always read as stale so the full audit replaces it.
+	Result += FString::Printf(TEXT("# %s\n"), *Data.Name);
+	Result += FString::Printf(TEXT("Path: %s\n"), *Data.Path);
+	Result += TEXT("Tier: Stub\n");
+	Result += FString::Printf(TEXT("Class: %s\n"), *Data.AssetClass);
+	if (!Data.ParentClass.IsEmpty())
+	{
+		Result += FString::Printf(TEXT("Parent: %s\n"), *Data.ParentClass);
+	}
+	if (!Data.NativeParentClass.IsEmpty() && Data.NativeParentClass != Data.ParentClass)
+	{
+		Result += FString::Printf(TEXT("NativeParent: %s\n"), *Data.NativeParentClass);
+	}
+	if (Data.DiskSize >= 0)
+	{
+		Result += FString::Printf(TEXT("Size: %lld\n"), Data.DiskSize);
+	}
+	if (!Data.SourceFilePath.IsEmpty())
+	{
+		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
+	}
+
+	if (Data.Interfaces.Num() > 0)
+	{
+		Result += TEXT("\n## Interfaces\n");
+		for (const FString& Interface : Data.Interfaces)
+		{
+			Result += FString::Printf(TEXT("- %s\n"), *Interface);
+		}
+	}
+
+	if (Data.Dependencies.Num() > 0)
+	{
+		Result += FString::Printf(TEXT("\n## Dependencies (%d)\n"), Data.Dependencies.Num());
+		for (const FString& Dependency : Data.Dependencies)
+		{
+			Result += FString::Printf(TEXT("- %s\n"), *Dependency);
+		}
+	}
+
+	return Result;
+}
@@ -0,0 +1,663 @@
+#include "Audit/AuditAssetUtils.h"
+
+#include "Audit/AssetStubAuditor.h"
+#include "Audit/AuditCache.h"
+#include "Audit/AuditCompactBinary.h"
+#include "Audit/AuditExtensionRegistry.h"
+#include "Audit/AuditFileUtils.h"
+#include "Audit/AuditMigrations.h"
+#include "BlueprintAuditor.h"
+#include "FathomControlRig.h"
+#include "FathomUELinkModule.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "Engine/Blueprint.h"
+#include "Engine/DataAsset.h"
+#include "Engine/DataTable.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "StructUtils/UserDefinedStruct.h"
+#include "UObject/GarbageCollection.h"
+
+namespace
+{
+	/** Age after which the orphan sweep treats a *.tmp file as left behind by a crash. */
+	constexpr double StaleTempFileMinutes = 60.0;
+
+	/** Names match the "AuditSchema: <Name>/<N>" line each auditor writes. */
+	const TMap<FString, int32>& GetCoreSchemaVersions()
+	{
+		static const TMap<FString, int32> Versions = {
+			{ TEXT("Blueprint"), FBlueprintGraphAuditor::SchemaVersion },
+			{ TEXT("DataTable"), FDataTableAuditor::SchemaVersion },
+			{ TEXT("DataAsset"), FDataAssetAuditor::SchemaVersion },
+			{ TEXT("UserDefinedStruct"), FUserDefinedStructAuditor::SchemaVersion },
+			{ TEXT("ControlRig"), FControlRigAuditor::SchemaVersion },
+			{ TEXT("Material"), FMaterialAuditor::SchemaVersion },
+			{ TEXT("BehaviorTree"), FBehaviorTreeAuditor::SchemaVersion },
+		};
+		return Versions;
+	}
+
+	FStaleCheckEntry MakeEntry(const FString& PackageName, EAuditAssetType AssetType)
+	{
+		FStaleCheckEntry Entry;
+		Entry.PackageName = PackageName;
+		Entry.SourcePath = FAuditFileUtils::GetSourceFilePath(PackageName);
+		Entry.AuditPath = FAuditFileUtils::GetAuditOutputPath(PackageName);
+		Entry.AssetType = AssetType;
+		return Entry;
+	}
+
+	const FAuditExtensionRegistry::FExtension* FindHandlingExtension(const FAssetData& Asset)
+	{
+		for (const auto& Ext : FAuditExtensionRegistry::Get().GetExtensions())
+		{
+			if (Ext.IsHandledAsset && Ext.IsHandledAsset(Asset))
+			{
+				return &Ext;
+			}
+		}
+		return nullptr;
+	}
+
+	/** Append entries for every auditable asset of one class. */
+	void CollectClassEntries(IAssetRegistry& AssetRegistry, const UClass* Class, bool bSearchSubClasses,
+		EAuditAssetType AssetType, TArray<FStaleCheckEntry>& OutEntries)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByClass(Class->GetClassPathName(), Assets, bSearchSubClasses);
+
+		for (const FAssetData& Asset : Assets)
+		{
+			const FString PackageName = Asset.PackageName.ToString();
+			if (!FAuditFileUtils::IsAuditablePackage(PackageName))
+			{
+				continue;
+			}
+
+			if (AssetType == EAuditAssetType::Blueprint && !FAuditFileUtils::IsSupportedBlueprintClass(Asset.AssetClassPath))
+			{
+				UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Skipping unsupported Blueprint class %s (%s)"),
+					*PackageName, *Asset.AssetClassPath.ToString());
+				continue;
+			}
+
+			// Skip assets handled by extension auditors (e.g. StateTree inherits UDataAsset)
+			if (AssetType == EAuditAssetType::DataAsset && FindHandlingExtension(Asset))
+			{
+				continue;
+			}
+
+			OutEntries.Add(MakeEntry(PackageName, AssetType));
+		}
+	}
+
+	/** Wrap gathered POD data into a write task that serializes and writes it. */
+	template <typename TData>
+	FAuditWriteTask MakeWriteTask(TData&& Data, FString (*Serialize)(const TData&))
+	{
+		FAuditWriteTask Task;
+		Task.PackageName = Data.PackageName;
+		Task.Execute = [MovedData = MoveTemp(Data), Serialize]()
+		{
+			FAuditCompactBinary::WriteSidecar(MovedData);
+			return FAuditFileUtils::WriteAuditFile(Serialize(MovedData), MovedData.OutputPath);
+		};
+		return Task;
+	}
+
+	/** True if the object can be read off the game thread: fully loaded and not being edited. */
+	bool CanGatherOnWorker(const UObject* Object)
+	{
+		return !Object->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad)
+			&& !Object->GetOutermost()->IsDirty();
+	}
+
+	/**
+	 * Roots an object for a deferred gather and unroots it once the gather is done or
+	 * the last copy of the task is destroyed, whether it ran, was cancelled or was
+	 * dropped. Objects that are already rooted (e.g. by the editor) are left rooted.
+	 */
+	class FDeferredGatherRoot
+	{
+	public:
+		explicit FDeferredGatherRoot(UObject* InObject)
+			: Object(InObject)
+			, bAddedToRoot(!InObject->IsRooted())
+		{
+			if (bAddedToRoot)
+			{
+				Object->AddToRoot();
+			}
+		}
+
+		~FDeferredGatherRoot()
+		{
+			Release();
+		}
+
+		UE_NONCOPYABLE(FDeferredGatherRoot);
+
+		void Release()
+		{
+			if (bAddedToRoot)
+			{
+				Object->RemoveFromRoot();
+				bAddedToRoot = false;
+			}
+		}
+
+	private:
+		UObject* Object;
+		bool bAddedToRoot;
+	};
+
+	/** On-disk timestamp of a package's .uasset, or FDateTime::MinValue() if it has none. */
+	FDateTime GetPackageTimeStamp(const FString& PackageName)
+	{
+		FString Filename;
+		return FPackageName::TryConvertLongPackageNameToFilename(PackageName, Filename, FPackageName::GetAssetPackageExtension())
+			? IFileManager::Get().GetTimeStamp(*Filename) : FDateTime::MinValue();
+	}
+
+	/**
+	 * Wrap an object into a write task that gathers, serializes and writes it on
+	 * whichever thread runs the task. Only for auditors whose gather is worker-safe.
+	 */
+	template <typename TAuditor, typename TObject>
+	FAuditWriteTask MakeDeferredGatherTask(const TObject* Object)
+	{
+		static_assert(TAuditor::bGatherIsWorkerSafe, "Auditor gather is not marked worker-safe");
+
+		// Keep the object alive until the worker has gathered it
+		TObject* MutableObject = const_cast<TObject*>(Object);
+		const TSharedRef<FDeferredGatherRoot, ESPMode::ThreadSafe> Root = MakeShared<FDeferredGatherRoot, ESPMode::ThreadSafe>(MutableObject);
+
+		FAuditWriteTask Task;
+		Task.PackageName = Object->GetOutermost()->GetName();
+		Task.Execute = [MutableObject, Root, PackageName = Task.PackageName, SavedAt = GetPackageTimeStamp(Task.PackageName)]()
+		{
+			decltype(TAuditor::GatherData(MutableObject)) Data;
+			bool bChanged = false;
+			{
+				FGCScopeGuard GCGuard;
+				Data = TAuditor::GatherData(MutableObject);
+
+				// GC is blocked but editing is not: an edit (or a save) while the worker read
+				// the object may have torn the data. The next save or stale check re-audits it.
+				bChanged = MutableObject->GetOutermost()->IsDirty();
+				Root->Release();
+			}
+			if (bChanged || GetPackageTimeStamp(PackageName) != SavedAt)
+			{
+				UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: %s changed while it was gathered, audit discarded"), *PackageName);
+				return false;
+			}
+
+			FAuditCompactBinary::WriteSidecar(Data);
+			return FAuditFileUtils::WriteAuditFile(TAuditor::SerializeToMarkdown(Data), Data.OutputPath);
+		};
+		return Task;
+	}
+
+	/** An audit's format version against the current version of the auditor that wrote it. */
+	struct FSchemaGap
+	{
+		FString Auditor;
+		int32 StoredVersion = 1;
+		int32 CurrentVersion = 0;
+
+		/** No AuditSchema line and several auditors could have written it. */
+		bool bAmbiguous = false;
+
+		bool IsBehind() const { return CurrentVersion != 0 && CurrentVersion != StoredVersion; }
+	};
+
+	/**
+	 * Read the AuditSchema line of a full audit (stubs never get here: they have no Hash
+	 * line). Audits from before per-auditor versions have no line and are version 1 of
+	 * the auditor the entry's type maps to.
+	 */
+	FSchemaGap GetSchemaGap(const FString& Content, EAuditAssetType AssetType)
+	{
+		FSchemaGap Gap;
+		if (FAuditFileUtils::ParseAuditSchema(Content, Gap.Auditor, Gap.StoredVersion))
+		{
+			Gap.CurrentVersion = FAuditAssetUtils::GetSchemaVersion(Gap.Auditor);
+			return Gap;
+		}
+
+		Gap.StoredVersion = 1;
+		TArray<FString> Auditors;
+		FAuditAssetUtils::GetAuditorNames(AssetType, Auditors);
+		for (const FString& Candidate : Auditors)
+		{
+			// Blueprint entries may hold either auditor's output: behind if any is past 1
+			const int32 Version = FAuditAssetUtils::GetSchemaVersion(Candidate);
+			if (Version > Gap.CurrentVersion)
+			{
+				Gap.CurrentVersion = Version;
+				Gap.Auditor = Candidate;
+			}
+		}
+		Gap.bAmbiguous = Auditors.Num() > 1;
+		return Gap;
+	}
+
+	/** Text migration can bring the audit current: which auditor wrote it is known and every step is registered. */
+	bool CanMigrate(const FSchemaGap& Gap)
+	{
+		// Not with sidecars on: the .ucb would keep the old schema, so re-audit both
+		return !Gap.bAmbiguous && !FAuditCompactBinary::IsEnabled()
+			&& FAuditMigrationRegistry::Get().CanMigrate(Gap.Auditor, Gap.StoredVersion, Gap.CurrentVersion);
+	}
+}
+
+bool FAuditAssetUtils::TryMakeEntry(const FAssetData& Asset, FStaleCheckEntry& OutEntry)
+{
+	const FString PackageName = Asset.PackageName.ToString();
+	if (!FAuditFileUtils::IsAuditablePackage(PackageName))
+	{
+		return false;
+	}
+
+	if (Asset.IsInstanceOf(UBlueprint::StaticClass()))
+	{
+		if (!FAuditFileUtils::IsSupportedBlueprintClass(Asset.AssetClassPath))
+		{
+			return false;
+		}
+		OutEntry = MakeEntry(PackageName, EAuditAssetType::Blueprint);
+		return true;
+	}
+
+	if (Asset.IsInstanceOf(UDataTable::StaticClass()))
+	{
+		OutEntry = MakeEntry(PackageName, EAuditAssetType::DataTable);
+		return true;
+	}
+
+	// Extensions take precedence over the generic DataAsset auditor
+	if (const FAuditExtensionRegistry::FExtension* Ext = FindHandlingExtension(Asset))
+	{
+		OutEntry = MakeEntry(PackageName, Ext->AssetType);
+		return true;
+	}
+
+	if (Asset.IsInstanceOf(UDataAsset::StaticClass()))
+	{
+		OutEntry = MakeEntry(PackageName, EAuditAssetType::DataAsset);
+		return true;
+	}
+
+	if (Asset.IsInstanceOf(UUserDefinedStruct::StaticClass()))
+	{
+		OutEntry = MakeEntry(PackageName, EAuditAssetType::UserDefinedStruct);
+		return true;
+	}
+
+	if (Asset.IsInstanceOf(UMaterial::StaticClass()) || Asset.IsInstanceOf(UMaterialInstanceConstant::StaticClass()))
+	{
+		OutEntry = MakeEntry(PackageName, EAuditAssetType::Material);
+		return true;
+	}
+
+	if (Asset.IsInstanceOf(UBehaviorTree::StaticClass()))
+	{
+		OutEntry = MakeEntry(PackageName, EAuditAssetType::BehaviorTree);
+		return true;
+	}
+
+	return false;
+}
+
+void FAuditAssetUtils::CollectEntries(IAssetRegistry& AssetRegistry, TArray<FStaleCheckEntry>& OutEntries)
+{
+	CollectClassEntries(AssetRegistry, UBlueprint::StaticClass(), true, EAuditAssetType::Blueprint, OutEntries);
+	CollectClassEntries(AssetRegistry, UDataTable::StaticClass(), false, EAuditAssetType::DataTable, OutEntries);
+	CollectClassEntries(AssetRegistry, UDataAsset::StaticClass(), true, EAuditAssetType::DataAsset, OutEntries);
+	CollectClassEntries(AssetRegistry, UUserDefinedStruct::StaticClass(), false, EAuditAssetType::UserDefinedStruct, OutEntries);
+	CollectClassEntries(AssetRegistry, UMaterial::StaticClass(), false, EAuditAssetType::Material, OutEntries);
+	CollectClassEntries(AssetRegistry, UMaterialInstanceConstant::StaticClass(), false, EAuditAssetType::Material, OutEntries);
+	CollectClassEntries(AssetRegistry, UBehaviorTree::StaticClass(), false, EAuditAssetType::BehaviorTree, OutEntries);
+
+	// Extension auditors (e.g. StateTree)
+	for (const auto& Ext : FAuditExtensionRegistry::Get().GetExtensions())
+	{
+		if (Ext.BuildStaleCheckList)
+		{
+			Ext.BuildStaleCheckList(AssetRegistry, OutEntries);
+		}
+	}
+}
+
+TOptional<FAuditWriteTask> FAuditAssetUtils::LoadAndGather(const FStaleCheckEntry& Entry)
+{
+	const FString& PackageName = Entry.PackageName;
+	const FString AssetPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+
+	switch (Entry.AssetType)
+	{
+	case EAuditAssetType::Blueprint:
+	{
+		UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *AssetPath);
+		if (!BP)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load Blueprint %s"), *PackageName);
+			return {};
+		}
+#if FATHOM_HAS_CONTROLRIG_BLUEPRINT
+		if (const UControlRigBlueprint* CRBP = Cast<UControlRigBlueprint>(BP))
+		{
+			return MakeWriteTask(FControlRigAuditor::GatherData(CRBP), &FControlRigAuditor::SerializeToMarkdown);
+		}
+#endif
+		return MakeWriteTask(FBlueprintGraphAuditor::GatherBlueprintData(BP), &FBlueprintGraphAuditor::SerializeToMarkdown);
+	}
+	case EAuditAssetType::DataTable:
+	{
+		const UDataTable* DT = LoadObject<UDataTable>(nullptr, *AssetPath);
+		if (!DT)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load DataTable %s"), *PackageName);
+			return {};
+		}
+		return MakeGatherTask(DT);
+	}
+	case EAuditAssetType::DataAsset:
+	{
+		const UDataAsset* DA = LoadObject<UDataAsset>(nullptr, *AssetPath);
+		if (!DA)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load DataAsset %s"), *PackageName);
+			return {};
+		}
+		return MakeWriteTask(FDataAssetAuditor::GatherData(DA), &FDataAssetAuditor::SerializeToMarkdown);
+	}
+	case EAuditAssetType::UserDefinedStruct:
+	{
+		const UUserDefinedStruct* UDS = LoadObject<UUserDefinedStruct>(nullptr, *AssetPath);
+		if (!UDS)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load UserDefinedStruct %s"), *PackageName);
+			return {};
+		}
+		return MakeGatherTask(UDS);
+	}
+	case EAuditAssetType::Material:
+	{
+		const UMaterialInterface* Mat = LoadObject<UMaterialInterface>(nullptr, *AssetPath);
+		if (!Mat)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load Material %s"), *PackageName);
+			return {};
+		}
+		return MakeWriteTask(FMaterialAuditor::GatherData(Mat), &FMaterialAuditor::SerializeToMarkdown);
+	}
+	case EAuditAssetType::BehaviorTree:
+	{
+		const UBehaviorTree* BT = LoadObject<UBehaviorTree>(nullptr, *AssetPath);
+		if (!BT)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load BehaviorTree %s"), *PackageName);
+			return {};
+		}
+		return MakeWriteTask(FBehaviorTreeAuditor::GatherData(BT), &FBehaviorTreeAuditor::SerializeToMarkdown);
+	}
+	default:
+	{
+		for (const auto& Ext : FAuditExtensionRegistry::Get().GetExtensions())
+		{
+			if (Ext.ReAuditStaleEntry)
+			{
+				TOptional<FAuditWriteTask> Task = Ext.ReAuditStaleEntry(Entry);
+				if (Task.IsSet())
+				{
+					return Task;
+				}
+			}
+		}
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: No handler for asset %s (type %d)"),
+			*PackageName, static_cast<int32>(Entry.AssetType));
+		return {};
+	}
+	}
+}
+
+FAuditWriteTask FAuditAssetUtils::MakeGatherTask(const UDataTable* DataTable)
+{
+	if (CanGatherOnWorker(DataTable))
+	{
+		return MakeDeferredGatherTask<FDataTableAuditor>(DataTable);
+	}
+	return MakeWriteTask(FDataTableAuditor::GatherData(DataTable), &FDataTableAuditor::SerializeToMarkdown);
+}
+
+FAuditWriteTask FAuditAssetUtils::MakeGatherTask(const UUserDefinedStruct* Struct)
+{
+	if (CanGatherOnWorker(Struct))
+	{
+		return MakeDeferredGatherTask<FUserDefinedStructAuditor>(Struct);
+	}
+	return MakeWriteTask(FUserDefinedStructAuditor::GatherData(Struct), &FUserDefinedStructAuditor::SerializeToMarkdown);
+}
+
+bool FAuditAssetUtils::GatherStub(IAssetRegistry& AssetRegistry, const FStaleCheckEntry& Entry, FAssetStubAuditData& OutData)
+{
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPackageName(FName(*Entry.PackageName), Assets);
+	if (Assets.Num() == 0)
+	{
+		return false;
+	}
+
+	// Prefer the package's primary asset (same name as the package) over any
+	// secondary objects the registry lists for it
+	const FName ShortName(*FPackageName::GetShortName(Entry.PackageName));
+	const FAssetData* Primary = Assets.FindByPredicate([&ShortName](const FAssetData& Asset)
+	{
+		return Asset.AssetName == ShortName;
+	});
+
+	OutData = FAssetStubAuditor::GatherData(Primary ? *Primary : Assets[0], AssetRegistry);
+	return true;
+}
+
+bool FAuditAssetUtils::WriteStubIfMissing(const FAssetStubAuditData& Data)
+{
+	// Checked and queued under the write queue's lock: a full audit queued meanwhile must
+	// not be replaced by the stub
+	return FAuditFileUtils::WriteAuditFileIfMissing(FAssetStubAuditor::SerializeToMarkdown(Data), Data.OutputPath);
+}
+
+EAuditStaleness FAuditAssetUtils::GetAuditStaleness(const FStaleCheckEntry& Entry)
+{
+	if (Entry.SourcePath.IsEmpty())
+	{
+		return EAuditStaleness::Fresh;
+	}
+
+	const FString CurrentHash = FAuditFileUtils::ComputeFileHash(Entry.SourcePath);
+	if (CurrentHash.IsEmpty())
+	{
+		return EAuditStaleness::Fresh;
+	}
+
+	FString Content;
+	if (!FAuditFileUtils::LoadAuditFile(Entry.AuditPath, Content) || CurrentHash != FAuditFileUtils::ParseSourceHash(Content))
+	{
+		return EAuditStaleness::Stale;
+	}
+
+	const FSchemaGap Gap = GetSchemaGap(Content, Entry.AssetType);
+	if (!Gap.IsBehind())
+	{
+		return EAuditStaleness::Fresh;
+	}
+
+	// Source unchanged, format behind: the caller carries it forward as text
+	return CanMigrate(Gap) ? EAuditStaleness::NeedsMigration : EAuditStaleness::Stale;
+}
+
+bool FAuditAssetUtils::MigrateAudit(const FStaleCheckEntry& Entry)
+{
+	FString Content;
+	if (!FAuditFileUtils::LoadAuditFile(Entry.AuditPath, Content))
+	{
+		return false;
+	}
+
+	const FSchemaGap Gap = GetSchemaGap(Content, Entry.AssetType);
+	if (!Gap.IsBehind() || !CanMigrate(Gap)
+		|| !FAuditMigrationRegistry::Get().Migrate(Gap.Auditor, Gap.StoredVersion, Gap.CurrentVersion, Content)
+		|| !FAuditFileUtils::WriteAuditFile(Content, Entry.AuditPath, /*bMigration=*/ true))
+	{
+		return false;
+	}
+
+	UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Migrated %s from %s/%d to %d"),
+		*Entry.PackageName, *Gap.Auditor, Gap.StoredVersion, Gap.CurrentVersion);
+	return true;
+}
+
+int32 FAuditAssetUtils::GetSchemaVersion(const FString& Auditor)
+{
+	if (const int32* Version = GetCoreSchemaVersions().Find(Auditor))
+	{
+		return *Version;
+	}
+
+	// Called from worker threads, so extensions are read under the registry's lock
+	const FName ExtensionName(*Auditor, FNAME_Find);
+	int32 Version = 0;
+	FAuditExtensionRegistry::Get().ForEachExtension([&ExtensionName, &Version](const FAuditExtensionRegistry::FExtension& Ext)
+	{
+		if (Version == 0 && Ext.Name == ExtensionName)
+		{
+			Version = Ext.SchemaVersion;
+		}
+	});
+	return Version;
+}
+
+void FAuditAssetUtils::GetAuditorNames(EAuditAssetType AssetType, TArray<FString>& OutAuditors)
+{
+	switch (AssetType)
+	{
+	case EAuditAssetType::Blueprint:
+		// Control Rig blueprints are collected as Blueprints but have their own auditor
+		OutAuditors.Add(TEXT("Blueprint"));
+		OutAuditors.Add(TEXT("ControlRig"));
+		return;
+	case EAuditAssetType::ControlRig:        OutAuditors.Add(TEXT("ControlRig")); return;
+	case EAuditAssetType::DataTable:         OutAuditors.Add(TEXT("DataTable")); return;
+	case EAuditAssetType::UserDefinedStruct: OutAuditors.Add(TEXT("UserDefinedStruct")); return;
+	case EAuditAssetType::Material:          OutAuditors.Add(TEXT("Material")); return;
+	case EAuditAssetType::BehaviorTree:      OutAuditors.Add(TEXT("BehaviorTree")); return;
+	default:
+		break;
+	}
+
+	// Extensions record their own (or a shared) asset type; DataAsset entries may be either
+	FAuditExtensionRegistry::Get().ForEachExtension([AssetType, &OutAuditors](const FAuditExtensionRegistry::FExtension& Ext)
+	{
+		if (Ext.AssetType == AssetType)
+		{
+			OutAuditors.Add(Ext.Name.ToString());
+		}
+	});
+	if (AssetType == EAuditAssetType::DataAsset)
+	{
+		OutAuditors.Add(TEXT("DataAsset"));
+	}
+}
+
+TMap<FString, int32> FAuditAssetUtils::GetSchemaVersions()
+{
+	TMap<FString, int32> Versions = GetCoreSchemaVersions();
+	FAuditExtensionRegistry::Get().ForEachExtension([&Versions](const FAuditExtensionRegistry::FExtension& Ext)
+	{
+		Versions.Add(Ext.Name.ToString(), Ext.SchemaVersion);
+	});
+	return Versions;
+}
+
+int32 FAuditAssetUtils::SweepOrphanedAuditFiles(IAssetRegistry& AssetRegistry, const FString& BaseDir)
+{
+	TArray<FString> AuditFiles;
+	FAuditFileUtils::FindAuditFiles(BaseDir, AuditFiles);
+
+	int32 SweptCount = 0;
+	for (const FString& AuditFile : AuditFiles)
+	{
+		FString RelPath = AuditFile;
+		if (!RelPath.StartsWith(BaseDir))
+		{
+			continue;
+		}
+		RelPath.RightChopInline(BaseDir.Len());
+
+		if (RelPath.StartsWith(TEXT("/")) || RelPath.StartsWith(TEXT("\\")))
+		{
+			RelPath.RightChopInline(1);
+		}
+
+		RelPath.RemoveFromEnd(FAuditFileUtils::CompressedSuffix);
+		if (RelPath.EndsWith(TEXT(".md")))
+		{
+			RelPath.LeftChopInline(3);
+		}
+
+		RelPath.ReplaceInline(TEXT("\\"), TEXT("/"));
+
+		const FString PackageName = FAuditFileUtils::PackageNameFromRelativeAuditPath(RelPath);
+		if (PackageName.IsEmpty())
+		{
+			continue;
+		}
+
+		// Audit policy may have changed since this file was written (e.g. external
+		// actors/objects are no longer auditable). Drop anything that no longer
+		// belongs, regardless of whether the underlying asset still exists.
+		if (!FAuditFileUtils::IsAuditablePackage(PackageName))
+		{
+			FAuditFileUtils::DeleteAuditFile(AuditFile);
+			++SweptCount;
+			continue;
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(FName(*PackageName), Assets, true);
+		if (Assets.IsEmpty())
+		{
+			FAuditFileUtils::DeleteAuditFile(AuditFile);
+			++SweptCount;
+		}
+	}
+
+	// Temp files left by a process killed mid-write. Only old ones: another process
+	// sharing the tree may be writing the rest right now.
+	TArray<FString> TempFiles;
+	IFileManager::Get().FindFilesRecursive(TempFiles, *BaseDir, TEXT("*.tmp"), true, false);
+	const FDateTime Cutoff = FDateTime::UtcNow() - FTimespan::FromMinutes(StaleTempFileMinutes);
+	int32 TempCount = 0;
+	for (const FString& TempFile : TempFiles)
+	{
+		const FDateTime Modified = IFileManager::Get().GetTimeStamp(*TempFile);
+		if (Modified != FDateTime::MinValue() && Modified < Cutoff && IFileManager::Get().Delete(*TempFile, false, false, true))
+		{
+			++TempCount;
+		}
+	}
+
+	if (SweptCount > 0 || TempCount > 0)
+	{
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Swept %d orphaned audit file(s) and %d stale temp file(s) from %s"),
+			SweptCount, TempCount, *BaseDir);
+	}
+	return SweptCount;
+}
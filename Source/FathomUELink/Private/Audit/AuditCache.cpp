@@ -0,0 +1,222 @@
+#include "Audit/AuditCache.h"
+
+#include "Audit/AuditAssetUtils.h"
+#include "Audit/AuditCompactBinary.h"
+#include "Audit/AuditFileUtils.h"
+#include "FathomAuditSettings.h"
+#include "FathomUELinkModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	struct FCacheConfig
+	{
+		FString Dir;
+		bool bPublish = false;
+	};
+
+	/** Settings, overridden by -AuditCache=<Dir> and -PublishAuditCache (CI runs). */
+	const FCacheConfig& GetConfig()
+	{
+		static const FCacheConfig Config = []()
+		{
+			const UFathomAuditSettings* Settings = GetDefault<UFathomAuditSettings>();
+			FString Dir = Settings->SharedAuditCacheDirectory.Path;
+			FParse::Value(FCommandLine::Get(), TEXT("-AuditCache="), Dir);
+			Dir.TrimStartAndEndInline();
+
+			FCacheConfig Result;
+			if (!Dir.IsEmpty())
+			{
+				Result.Dir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Dir);
+				FPaths::NormalizeDirectoryName(Result.Dir);
+				Result.bPublish = Settings->bPublishToSharedAuditCache || FParse::Param(FCommandLine::Get(), TEXT("PublishAuditCache"));
+			}
+			return Result;
+		}();
+		return Config;
+	}
+
+	/** True if the audit's Path header names PackageName (identical bytes under another name don't count). */
+	bool IsAuditOfPackage(const FString& Content, const FString& PackageName)
+	{
+		const int32 HeaderEnd = Content.Find(TEXT("\n\n"));
+		const int32 PathPos = Content.Find(TEXT("\nPath: ") + PackageName + TEXT("."), ESearchCase::CaseSensitive);
+		return PathPos != INDEX_NONE && (HeaderEnd == INDEX_NONE || PathPos < HeaderEnd);
+	}
+}
+
+FAuditCache& FAuditCache::Get()
+{
+	static FAuditCache Instance;
+	return Instance;
+}
+
+bool FAuditCache::IsEnabled()
+{
+	return !GetConfig().Dir.IsEmpty();
+}
+
+bool FAuditCache::IsPublishing()
+{
+	return GetConfig().bPublish;
+}
+
+FString FAuditCache::GetCacheDir()
+{
+	return GetConfig().Dir;
+}
+
+FString FAuditCache::GetEntryPath(const FString& SourceHash, const FString& Auditor, int32 Version)
+{
+	return FString::Printf(TEXT("%s/v%d/%s/%s.%s-%d.md%s"), *GetConfig().Dir, FAuditFileUtils::AuditSchemaVersion,
+		*SourceHash.Left(2), *SourceHash, *Auditor, Version, FAuditFileUtils::CompressedSuffix);
+}
+
+bool FAuditCache::TryRestore(const FStaleCheckEntry& Entry)
+{
+	if (!IsEnabled() || Entry.SourcePath.IsEmpty())
+	{
+		return false;
+	}
+	return TryRestore(Entry, FAuditFileUtils::ComputeFileHash(Entry.SourcePath));
+}
+
+bool FAuditCache::TryRestore(const FStaleCheckEntry& Entry, const FString& SourceHash)
+{
+	// The cache holds Markdown only; a restored audit would have no sidecar
+	if (!IsEnabled() || SourceHash.IsEmpty() || FAuditCompactBinary::IsEnabled())
+	{
+		return false;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (KnownMisses.Contains(SourceHash))
+		{
+			return false;
+		}
+	}
+
+	TArray<FString> Auditors;
+	FAuditAssetUtils::GetAuditorNames(Entry.AssetType, Auditors);
+	for (const FString& Auditor : Auditors)
+	{
+		const int32 Version = FAuditAssetUtils::GetSchemaVersion(Auditor);
+		if (Version == 0)
+		{
+			continue;
+		}
+
+		const FString EntryPath = GetEntryPath(SourceHash, Auditor, Version);
+		TArray<uint8> Compressed;
+		FString Content;
+		if (!FFileHelper::LoadFileToArray(Compressed, *EntryPath, FILEREAD_Silent)
+			|| !FAuditFileUtils::DecompressAuditContent(Compressed, Content))
+		{
+			continue;
+		}
+
+		FString CachedAuditor;
+		int32 CachedVersion = 0;
+		if (FAuditFileUtils::ParseSourceHash(Content) != SourceHash
+			|| !FAuditFileUtils::ParseAuditSchema(Content, CachedAuditor, CachedVersion)
+			|| CachedAuditor != Auditor || CachedVersion != Version
+			|| !IsAuditOfPackage(Content, Entry.PackageName))
+		{
+			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Shared cache entry %s does not match %s, ignored"), *EntryPath, *Entry.PackageName);
+			continue;
+		}
+
+		// Known before the write so Store does not look the entry up again
+		{
+			FScopeLock ScopeLock(&Lock);
+			KnownEntries.Add(EntryPath);
+		}
+		if (!FAuditFileUtils::WriteAuditFile(Content, Entry.AuditPath))
+		{
+			return false;
+		}
+
+		HitCount.Increment();
+		UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Restored %s from the shared audit cache"), *Entry.PackageName);
+		return true;
+	}
+
+	MissCount.Increment();
+	FScopeLock ScopeLock(&Lock);
+	KnownMisses.Add(SourceHash);
+	return false;
+}
+
+void FAuditCache::Store(const FString& Content)
+{
+	if (!IsPublishing())
+	{
+		return;
+	}
+
+	const FString SourceHash = FAuditFileUtils::ParseSourceHash(Content);
+	FString Auditor;
+	int32 Version = 0;
+	if (SourceHash.IsEmpty() || !FAuditFileUtils::ParseAuditSchema(Content, Auditor, Version))
+	{
+		return;
+	}
+
+	const FString EntryPath = GetEntryPath(SourceHash, Auditor, Version);
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (KnownEntries.Contains(EntryPath))
+		{
+			return;
+		}
+	}
+
+	IFileManager& FM = IFileManager::Get();
+	if (!FM.FileExists(*EntryPath))
+	{
+		TArray<uint8> Compressed;
+		if (!FAuditFileUtils::CompressAuditContent(Content, Compressed))
+		{
+			return;
+		}
+
+		// Unique temp name: other machines may be publishing the same entry right now
+		const FString TempPath = FString::Printf(TEXT("%s.%s.tmp"), *EntryPath, *FGuid::NewGuid().ToString());
+		if (!FFileHelper::SaveArrayToFile(Compressed, *TempPath))
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write shared cache entry %s"), *TempPath);
+			return;
+		}
+
+		if (FM.Move(*EntryPath, *TempPath, /*bReplace=*/ false, /*bEvenIfReadOnly=*/ true))
+		{
+			StoredCount.Increment();
+		}
+		else
+		{
+			// Lost the race; the entry that won is identical
+			FM.Delete(*TempPath);
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	KnownEntries.Add(EntryPath);
+	KnownMisses.Remove(SourceHash);
+}
+
+FAuditCache::FStats FAuditCache::GetStats() const
+{
+	FStats Stats;
+	Stats.Hits = HitCount.GetValue();
+	Stats.Misses = MissCount.GetValue();
+	Stats.Stored = StoredCount.GetValue();
+	return Stats;
+}
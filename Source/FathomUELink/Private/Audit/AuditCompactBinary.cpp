@@ -0,0 +1,573 @@
+#include "Audit/AuditCompactBinary.h"
+
+#include "Audit/BehaviorTreeAuditor.h"
+#include "Audit/BlueprintGraphAuditor.h"
+#include "Audit/ControlRigAuditor.h"
+#include "Audit/DataAssetAuditor.h"
+#include "Audit/DataTableAuditor.h"
+#include "Audit/MaterialAuditor.h"
+#include "Audit/UserDefinedStructAuditor.h"
+#include "FathomAuditSettings.h"
+#include "FathomUELinkModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/CompactBinaryWriter.h"
+
+namespace
+{
+	void BeginRoot(FCbWriter& Writer, const TCHAR* Auditor, int32 SchemaVersion,
+		const FString& Name, const FString& Path, const FString& PackageName)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("auditor"), Auditor);
+		Writer.AddInteger(UTF8TEXTVIEW("schema"), SchemaVersion);
+		Writer.AddString(UTF8TEXTVIEW("name"), Name);
+		Writer.AddString(UTF8TEXTVIEW("path"), Path);
+		Writer.AddString(UTF8TEXTVIEW("packageName"), PackageName);
+	}
+
+	void WriteStrings(FCbWriter& Writer, FUtf8StringView Name, const TArray<FString>& Values)
+	{
+		Writer.BeginArray(Name);
+		for (const FString& Value : Values)
+		{
+			Writer.AddString(Value);
+		}
+		Writer.EndArray();
+	}
+
+	void WriteNameValues(FCbWriter& Writer, FUtf8StringView Name, const TArray<FPropertyOverrideData>& Values)
+	{
+		Writer.BeginArray(Name);
+		for (const FPropertyOverrideData& Value : Values)
+		{
+			Writer.BeginObject();
+			Writer.AddString(UTF8TEXTVIEW("name"), Value.Name);
+			Writer.AddString(UTF8TEXTVIEW("value"), Value.Value);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+	}
+
+	void WriteNameValues(FCbWriter& Writer, FUtf8StringView Name, const TArray<FDefaultInputData>& Values)
+	{
+		Writer.BeginArray(Name);
+		for (const FDefaultInputData& Value : Values)
+		{
+			Writer.BeginObject();
+			Writer.AddString(UTF8TEXTVIEW("name"), Value.Name);
+			Writer.AddString(UTF8TEXTVIEW("value"), Value.Value);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+	}
+
+	void WriteNameValues(FCbWriter& Writer, FUtf8StringView Name, const TArray<FMaterialParameterData>& Values)
+	{
+		Writer.BeginArray(Name);
+		for (const FMaterialParameterData& Value : Values)
+		{
+			Writer.BeginObject();
+			Writer.AddString(UTF8TEXTVIEW("name"), Value.Name);
+			Writer.AddString(UTF8TEXTVIEW("value"), Value.Value);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+	}
+
+	void WriteParams(FCbWriter& Writer, FUtf8StringView Name, const TArray<FGraphParamData>& Params)
+	{
+		Writer.BeginArray(Name);
+		for (const FGraphParamData& Param : Params)
+		{
+			Writer.BeginObject();
+			Writer.AddString(UTF8TEXTVIEW("name"), Param.Name);
+			Writer.AddString(UTF8TEXTVIEW("type"), Param.Type);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+	}
+
+	void WriteVariables(FCbWriter& Writer, const TArray<FVariableAuditData>& Variables)
+	{
+		Writer.BeginArray(UTF8TEXTVIEW("variables"));
+		for (const FVariableAuditData& Variable : Variables)
+		{
+			Writer.BeginObject();
+			Writer.AddString(UTF8TEXTVIEW("name"), Variable.Name);
+			Writer.AddString(UTF8TEXTVIEW("type"), Variable.Type);
+			Writer.AddString(UTF8TEXTVIEW("category"), Variable.Category);
+			Writer.AddBool(UTF8TEXTVIEW("instanceEditable"), Variable.bInstanceEditable);
+			Writer.AddBool(UTF8TEXTVIEW("replicated"), Variable.bReplicated);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+	}
+
+	void WriteGraph(FCbWriter& Writer, const FGraphAuditData& Graph);
+
+	void WriteGraphs(FCbWriter& Writer, FUtf8StringView Name, const TArray<FGraphAuditData>& Graphs)
+	{
+		Writer.BeginArray(Name);
+		for (const FGraphAuditData& Graph : Graphs)
+		{
+			WriteGraph(Writer, Graph);
+		}
+		Writer.EndArray();
+	}
+
+	void WriteGraph(FCbWriter& Writer, const FGraphAuditData& Graph)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Graph.Name);
+		WriteParams(Writer, UTF8TEXTVIEW("inputs"), Graph.Inputs);
+		WriteParams(Writer, UTF8TEXTVIEW("outputs"), Graph.Outputs);
+
+		Writer.BeginArray(UTF8TEXTVIEW("nodes"));
+		for (const FNodeAuditData& Node : Graph.Nodes)
+		{
+			Writer.BeginObject();
+			Writer.AddInteger(UTF8TEXTVIEW("id"), Node.Id);
+			Writer.AddString(UTF8TEXTVIEW("type"), Node.Type);
+			Writer.AddString(UTF8TEXTVIEW("name"), Node.Name);
+			Writer.AddString(UTF8TEXTVIEW("target"), Node.Target);
+			Writer.AddBool(UTF8TEXTVIEW("native"), Node.bIsNative);
+			Writer.AddBool(UTF8TEXTVIEW("pure"), Node.bPure);
+			Writer.AddBool(UTF8TEXTVIEW("latent"), Node.bLatent);
+			WriteNameValues(Writer, UTF8TEXTVIEW("defaultInputs"), Node.DefaultInputs);
+			Writer.AddString(UTF8TEXTVIEW("compilerMessage"), Node.CompilerMessage);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+
+		Writer.BeginArray(UTF8TEXTVIEW("execFlows"));
+		for (const FExecEdge& Edge : Graph.ExecFlows)
+		{
+			Writer.BeginObject();
+			Writer.AddInteger(UTF8TEXTVIEW("source"), Edge.SourceNodeId);
+			Writer.AddString(UTF8TEXTVIEW("sourcePin"), Edge.SourcePinName);
+			Writer.AddInteger(UTF8TEXTVIEW("target"), Edge.TargetNodeId);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+
+		Writer.BeginArray(UTF8TEXTVIEW("dataFlows"));
+		for (const FDataEdge& Edge : Graph.DataFlows)
+		{
+			Writer.BeginObject();
+			Writer.AddInteger(UTF8TEXTVIEW("source"), Edge.SourceNodeId);
+			Writer.AddString(UTF8TEXTVIEW("sourcePin"), Edge.SourcePinName);
+			Writer.AddInteger(UTF8TEXTVIEW("target"), Edge.TargetNodeId);
+			Writer.AddString(UTF8TEXTVIEW("targetPin"), Edge.TargetPinName);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+
+		WriteGraphs(Writer, UTF8TEXTVIEW("subGraphs"), Graph.SubGraphs);
+		Writer.EndObject();
+	}
+
+	void WriteWidget(FCbWriter& Writer, const FWidgetAuditData& Widget)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Widget.Name);
+		Writer.AddString(UTF8TEXTVIEW("class"), Widget.Class);
+		Writer.AddBool(UTF8TEXTVIEW("variable"), Widget.bIsVariable);
+		Writer.AddString(UTF8TEXTVIEW("slotName"), Widget.SlotName);
+		Writer.BeginArray(UTF8TEXTVIEW("children"));
+		for (const FWidgetAuditData& Child : Widget.Children)
+		{
+			WriteWidget(Writer, Child);
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+	}
+
+	void WriteBTNode(FCbWriter& Writer, const FBTNodeAuditData& Node)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("type"), Node.Type);
+		Writer.AddString(UTF8TEXTVIEW("className"), Node.ClassName);
+		Writer.AddString(UTF8TEXTVIEW("decoratorLogic"), Node.DecoratorLogic);
+		Writer.AddString(UTF8TEXTVIEW("finishMode"), Node.FinishMode);
+		WriteNameValues(Writer, UTF8TEXTVIEW("properties"), Node.Properties);
+
+		Writer.BeginArray(UTF8TEXTVIEW("decorators"));
+		for (const FBTDecoratorAuditData& Decorator : Node.Decorators)
+		{
+			Writer.BeginObject();
+			Writer.AddString(UTF8TEXTVIEW("className"), Decorator.ClassName);
+			Writer.AddString(UTF8TEXTVIEW("abortMode"), Decorator.AbortMode);
+			Writer.AddBool(UTF8TEXTVIEW("inversed"), Decorator.bInversed);
+			WriteNameValues(Writer, UTF8TEXTVIEW("properties"), Decorator.Properties);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+
+		Writer.BeginArray(UTF8TEXTVIEW("services"));
+		for (const FBTServiceAuditData& Service : Node.Services)
+		{
+			Writer.BeginObject();
+			Writer.AddString(UTF8TEXTVIEW("className"), Service.ClassName);
+			Writer.AddFloat(UTF8TEXTVIEW("interval"), Service.Interval);
+			Writer.AddFloat(UTF8TEXTVIEW("randomDeviation"), Service.RandomDeviation);
+			WriteNameValues(Writer, UTF8TEXTVIEW("properties"), Service.Properties);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+
+		Writer.BeginArray(UTF8TEXTVIEW("children"));
+		for (const FBTNodeAuditData& Child : Node.Children)
+		{
+			WriteBTNode(Writer, Child);
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+	}
+}
+
+bool FAuditCompactBinary::IsEnabled()
+{
+	static const bool bEnabled = GetDefault<UFathomAuditSettings>()->bWriteCompactBinarySidecars;
+	return bEnabled;
+}
+
+FString FAuditCompactBinary::GetSidecarPath(const FString& AuditPath)
+{
+	return FPaths::ChangeExtension(AuditPath, SidecarExtension);
+}
+
+bool FAuditCompactBinary::SaveSidecar(const FString& AuditPath, FCbWriter& Writer)
+{
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(static_cast<int32>(Writer.GetSaveSize()));
+	Writer.Save(MakeMemoryView(Bytes));
+
+	// Same bytes as the file on disk: leave it alone, as for the audit itself
+	const FString SidecarPath = GetSidecarPath(AuditPath);
+	IFileManager& FM = IFileManager::Get();
+	TArray<uint8> Existing;
+	if (FM.FileSize(*SidecarPath) == Bytes.Num()
+		&& FFileHelper::LoadFileToArray(Existing, *SidecarPath, FILEREAD_Silent)
+		&& Existing == Bytes)
+	{
+		return true;
+	}
+
+	// Unique temp name: tasks on other threads (or processes) may write this sidecar too
+	const FString TempPath = FString::Printf(TEXT("%s.%s.tmp"), *SidecarPath, *FGuid::NewGuid().ToString());
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !FM.Move(*SidecarPath, *TempPath, true, true))
+	{
+		FM.Delete(*TempPath);
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write Compact Binary sidecar %s"), *SidecarPath);
+		return false;
+	}
+	return true;
+}
+
+void FAuditCompactBinary::DeleteSidecar(const FString& AuditPath)
+{
+	const FString SidecarPath = GetSidecarPath(AuditPath);
+	IFileManager& FM = IFileManager::Get();
+	if (FM.FileExists(*SidecarPath))
+	{
+		FM.Delete(*SidecarPath);
+	}
+}
+
+void FAuditCompactBinary::WriteSidecar(const FBlueprintAuditData& Data)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FCbWriter Writer;
+	BeginRoot(Writer, TEXT("Blueprint"), FBlueprintGraphAuditor::SchemaVersion, Data.Name, Data.Path, Data.PackageName);
+	Writer.AddString(UTF8TEXTVIEW("parentClass"), Data.ParentClass);
+	Writer.AddString(UTF8TEXTVIEW("blueprintType"), Data.BlueprintType);
+	Writer.AddString(UTF8TEXTVIEW("compileStatus"), Data.CompileStatus);
+	WriteVariables(Writer, Data.Variables);
+	WriteNameValues(Writer, UTF8TEXTVIEW("propertyOverrides"), Data.PropertyOverrides);
+	WriteStrings(Writer, UTF8TEXTVIEW("interfaces"), Data.Interfaces);
+
+	Writer.BeginArray(UTF8TEXTVIEW("components"));
+	for (const FComponentAuditData& Component : Data.Components)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Component.Name);
+		Writer.AddString(UTF8TEXTVIEW("class"), Component.Class);
+		Writer.AddString(UTF8TEXTVIEW("parent"), Component.ParentComponentName);
+		WriteNameValues(Writer, UTF8TEXTVIEW("propertyOverrides"), Component.PropertyOverrides);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	Writer.BeginArray(UTF8TEXTVIEW("timelines"));
+	for (const FTimelineAuditData& Timeline : Data.Timelines)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Timeline.Name);
+		Writer.AddFloat(UTF8TEXTVIEW("length"), Timeline.Length);
+		Writer.AddBool(UTF8TEXTVIEW("looping"), Timeline.bLooping);
+		Writer.AddBool(UTF8TEXTVIEW("autoPlay"), Timeline.bAutoPlay);
+		Writer.AddInteger(UTF8TEXTVIEW("floatTracks"), Timeline.FloatTrackCount);
+		Writer.AddInteger(UTF8TEXTVIEW("vectorTracks"), Timeline.VectorTrackCount);
+		Writer.AddInteger(UTF8TEXTVIEW("linearColorTracks"), Timeline.LinearColorTrackCount);
+		Writer.AddInteger(UTF8TEXTVIEW("eventTracks"), Timeline.EventTrackCount);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	WriteGraphs(Writer, UTF8TEXTVIEW("eventGraphs"), Data.EventGraphs);
+	WriteGraphs(Writer, UTF8TEXTVIEW("functionGraphs"), Data.FunctionGraphs);
+	WriteGraphs(Writer, UTF8TEXTVIEW("macroGraphs"), Data.MacroGraphs);
+
+	if (Data.WidgetTree.IsSet())
+	{
+		Writer.SetName(UTF8TEXTVIEW("widgetTree"));
+		WriteWidget(Writer, Data.WidgetTree.GetValue());
+	}
+	Writer.EndObject();
+
+	SaveSidecar(Data.OutputPath, Writer);
+}
+
+void FAuditCompactBinary::WriteSidecar(const FDataTableAuditData& Data)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FCbWriter Writer;
+	BeginRoot(Writer, TEXT("DataTable"), FDataTableAuditor::SchemaVersion, Data.Name, Data.Path, Data.PackageName);
+	Writer.AddString(UTF8TEXTVIEW("rowStruct"), Data.RowStructName);
+	Writer.AddString(UTF8TEXTVIEW("rowStructPath"), Data.RowStructPath);
+
+	Writer.BeginArray(UTF8TEXTVIEW("columns"));
+	for (const FDataTableColumnDef& Column : Data.Columns)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Column.Name);
+		Writer.AddString(UTF8TEXTVIEW("type"), Column.Type);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	// Row values are positional, in column order
+	Writer.BeginArray(UTF8TEXTVIEW("rows"));
+	for (const FDataTableRowData& Row : Data.Rows)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Row.RowName);
+		WriteStrings(Writer, UTF8TEXTVIEW("values"), Row.Values);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+
+	SaveSidecar(Data.OutputPath, Writer);
+}
+
+void FAuditCompactBinary::WriteSidecar(const FDataAssetAuditData& Data)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FCbWriter Writer;
+	BeginRoot(Writer, TEXT("DataAsset"), FDataAssetAuditor::SchemaVersion, Data.Name, Data.Path, Data.PackageName);
+	Writer.AddString(UTF8TEXTVIEW("nativeClass"), Data.NativeClass);
+	Writer.AddString(UTF8TEXTVIEW("nativeClassPath"), Data.NativeClassPath);
+	WriteNameValues(Writer, UTF8TEXTVIEW("properties"), Data.Properties);
+	Writer.EndObject();
+
+	SaveSidecar(Data.OutputPath, Writer);
+}
+
+void FAuditCompactBinary::WriteSidecar(const FUserDefinedStructAuditData& Data)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FCbWriter Writer;
+	BeginRoot(Writer, TEXT("UserDefinedStruct"), FUserDefinedStructAuditor::SchemaVersion, Data.Name, Data.Path, Data.PackageName);
+	Writer.BeginArray(UTF8TEXTVIEW("fields"));
+	for (const FStructFieldDef& Field : Data.Fields)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Field.Name);
+		Writer.AddString(UTF8TEXTVIEW("type"), Field.Type);
+		Writer.AddString(UTF8TEXTVIEW("defaultValue"), Field.DefaultValue);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+
+	SaveSidecar(Data.OutputPath, Writer);
+}
+
+void FAuditCompactBinary::WriteSidecar(const FControlRigAuditData& Data)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FCbWriter Writer;
+	BeginRoot(Writer, TEXT("ControlRig"), FControlRigAuditor::SchemaVersion, Data.Name, Data.Path, Data.PackageName);
+	Writer.AddString(UTF8TEXTVIEW("parentClass"), Data.ParentClass);
+	WriteVariables(Writer, Data.Variables);
+
+	Writer.BeginArray(UTF8TEXTVIEW("graphs"));
+	for (const FRigVMGraphAuditData& Graph : Data.Graphs)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Graph.Name);
+		Writer.AddBool(UTF8TEXTVIEW("root"), Graph.bIsRootGraph);
+		WriteParams(Writer, UTF8TEXTVIEW("inputs"), Graph.Inputs);
+		WriteParams(Writer, UTF8TEXTVIEW("outputs"), Graph.Outputs);
+
+		Writer.BeginArray(UTF8TEXTVIEW("nodes"));
+		for (const FRigVMNodeAuditData& Node : Graph.Nodes)
+		{
+			Writer.BeginObject();
+			Writer.AddInteger(UTF8TEXTVIEW("id"), Node.Id);
+			Writer.AddString(UTF8TEXTVIEW("type"), Node.Type);
+			Writer.AddString(UTF8TEXTVIEW("name"), Node.Name);
+			Writer.AddString(UTF8TEXTVIEW("structPath"), Node.StructPath);
+			Writer.AddString(UTF8TEXTVIEW("methodName"), Node.MethodName);
+			Writer.AddBool(UTF8TEXTVIEW("mutable"), Node.bIsMutable);
+			Writer.AddBool(UTF8TEXTVIEW("pure"), Node.bIsPure);
+			Writer.AddBool(UTF8TEXTVIEW("event"), Node.bIsEvent);
+			Writer.BeginArray(UTF8TEXTVIEW("pins"));
+			for (const FRigVMPinAuditData& Pin : Node.Pins)
+			{
+				Writer.BeginObject();
+				Writer.AddString(UTF8TEXTVIEW("name"), Pin.Name);
+				Writer.AddString(UTF8TEXTVIEW("cppType"), Pin.CPPType);
+				Writer.AddString(UTF8TEXTVIEW("direction"), Pin.Direction);
+				Writer.AddString(UTF8TEXTVIEW("defaultValue"), Pin.DefaultValue);
+				Writer.EndObject();
+			}
+			Writer.EndArray();
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+
+		Writer.BeginArray(UTF8TEXTVIEW("edges"));
+		for (const FRigVMEdgeAuditData& Edge : Graph.Edges)
+		{
+			Writer.BeginObject();
+			Writer.AddInteger(UTF8TEXTVIEW("source"), Edge.SourceNodeId);
+			Writer.AddString(UTF8TEXTVIEW("sourcePin"), Edge.SourcePinPath);
+			Writer.AddInteger(UTF8TEXTVIEW("target"), Edge.TargetNodeId);
+			Writer.AddString(UTF8TEXTVIEW("targetPin"), Edge.TargetPinPath);
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+
+	SaveSidecar(Data.OutputPath, Writer);
+}
+
+void FAuditCompactBinary::WriteSidecar(const FMaterialAuditData& Data)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FCbWriter Writer;
+	BeginRoot(Writer, TEXT("Material"), FMaterialAuditor::SchemaVersion, Data.Name, Data.Path, Data.PackageName);
+	Writer.AddBool(UTF8TEXTVIEW("materialInstance"), Data.bIsMaterialInstance);
+	Writer.AddString(UTF8TEXTVIEW("parentPath"), Data.ParentPath);
+	Writer.AddString(UTF8TEXTVIEW("materialDomain"), Data.MaterialDomain);
+	Writer.AddString(UTF8TEXTVIEW("blendMode"), Data.BlendMode);
+	Writer.AddString(UTF8TEXTVIEW("shadingModel"), Data.ShadingModel);
+	Writer.AddBool(UTF8TEXTVIEW("twoSided"), Data.bTwoSided);
+	Writer.AddInteger(UTF8TEXTVIEW("expressionCount"), Data.ExpressionCount);
+	Writer.AddInteger(UTF8TEXTVIEW("textureSampleCount"), Data.TextureSampleCount);
+	WriteNameValues(Writer, UTF8TEXTVIEW("scalarParameters"), Data.ScalarParameters);
+	WriteNameValues(Writer, UTF8TEXTVIEW("vectorParameters"), Data.VectorParameters);
+	WriteNameValues(Writer, UTF8TEXTVIEW("textureParameters"), Data.TextureParameters);
+	WriteNameValues(Writer, UTF8TEXTVIEW("staticSwitchParameters"), Data.StaticSwitchParameters);
+	WriteNameValues(Writer, UTF8TEXTVIEW("properties"), Data.Properties);
+
+	Writer.BeginArray(UTF8TEXTVIEW("expressions"));
+	for (const FMaterialExpressionData& Expression : Data.Expressions)
+	{
+		Writer.BeginObject();
+		Writer.AddInteger(UTF8TEXTVIEW("id"), Expression.Id);
+		Writer.AddString(UTF8TEXTVIEW("type"), Expression.Type);
+		Writer.AddString(UTF8TEXTVIEW("name"), Expression.Name);
+		WriteNameValues(Writer, UTF8TEXTVIEW("defaultInputs"), Expression.DefaultInputs);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	Writer.BeginArray(UTF8TEXTVIEW("edges"));
+	for (const FMaterialEdgeData& Edge : Data.Edges)
+	{
+		Writer.BeginObject();
+		Writer.AddInteger(UTF8TEXTVIEW("source"), Edge.SourceNodeId);
+		Writer.AddString(UTF8TEXTVIEW("sourcePin"), Edge.SourceOutput);
+		Writer.AddInteger(UTF8TEXTVIEW("target"), Edge.TargetNodeId);
+		Writer.AddString(UTF8TEXTVIEW("targetPin"), Edge.TargetInput);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	Writer.BeginArray(UTF8TEXTVIEW("outputs"));
+	for (const FMaterialOutputConnection& Output : Data.OutputConnections)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Output.OutputName);
+		Writer.AddInteger(UTF8TEXTVIEW("source"), Output.SourceNodeId);
+		Writer.AddString(UTF8TEXTVIEW("sourcePin"), Output.SourceOutput);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+
+	SaveSidecar(Data.OutputPath, Writer);
+}
+
+void FAuditCompactBinary::WriteSidecar(const FBehaviorTreeAuditData& Data)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FCbWriter Writer;
+	BeginRoot(Writer, TEXT("BehaviorTree"), FBehaviorTreeAuditor::SchemaVersion, Data.Name, Data.Path, Data.PackageName);
+	Writer.AddString(UTF8TEXTVIEW("blackboard"), Data.BlackboardAssetName);
+	Writer.AddString(UTF8TEXTVIEW("blackboardPath"), Data.BlackboardAssetPath);
+
+	Writer.BeginArray(UTF8TEXTVIEW("blackboardKeys"));
+	for (const FBlackboardKeyAuditData& Key : Data.BlackboardKeys)
+	{
+		Writer.BeginObject();
+		Writer.AddString(UTF8TEXTVIEW("name"), Key.Name);
+		Writer.AddString(UTF8TEXTVIEW("type"), Key.Type);
+		Writer.AddBool(UTF8TEXTVIEW("inherited"), Key.bInherited);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+
+	Writer.SetName(UTF8TEXTVIEW("root"));
+	WriteBTNode(Writer, Data.RootNode);
+	Writer.EndObject();
+
+	SaveSidecar(Data.OutputPath, Writer);
+}
@@ -1,5 +1,6 @@
 #include "Audit/AuditExtensionRegistry.h"
 #include "FathomUELinkModule.h"
+#include "Misc/ScopeRWLock.h"
 
 FAuditExtensionRegistry& FAuditExtensionRegistry::Get()
 {
@@ -10,11 +11,24 @@ FAuditExtensionRegistry& FAuditExtensionRegistry::Get()
 void FAuditExtensionRegistry::RegisterExtension(FExtension&& Extension)
 {
 	UE_LOG(LogFathomUELink, Log, TEXT("Fathom: Registered audit extension '%s'"), *Extension.Name.ToString());
+	FWriteScopeLock ScopeLock(ExtensionsLock);
 	Extensions.Add(MoveTemp(Extension));
 }
 
 void FAuditExtensionRegistry::UnregisterExtension(FName Name)
 {
-	Extensions.RemoveAll([Name](const FExtension& Ext) { return Ext.Name == Name; });
+	{
+		FWriteScopeLock ScopeLock(ExtensionsLock);
+		Extensions.RemoveAll([Name](const FExtension& Ext) { return Ext.Name == Name; });
+	}
 	UE_LOG(LogFathomUELink, Log, TEXT("Fathom: Unregistered audit extension '%s'"), *Name.ToString());
 }
+
+void FAuditExtensionRegistry::ForEachExtension(TFunctionRef<void(const FExtension&)> Visitor) const
+{
+	FReadScopeLock ScopeLock(ExtensionsLock);
+	for (const FExtension& Ext : Extensions)
+	{
+		Visitor(Ext);
+	}
+}
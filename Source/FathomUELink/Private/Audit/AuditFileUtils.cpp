@@ -1,10 +1,22 @@
 #include "Audit/AuditFileUtils.h"
 
+#include "Audit/AuditCache.h"
+#include "Audit/AuditCompactBinary.h"
+#include "Audit/AuditIndex.h"
+#include "Audit/AuditMigrations.h"
+#include "Audit/AuditPackStore.h"
+#include "Audit/AuditSectionIndex.h"
+#include "Audit/AuditWriteQueue.h"
+#include "FathomAuditSettings.h"
 #include "FathomUELinkModule.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraphPin.h"
 #include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Hash/xxhash.h"
 #include "Interfaces/IPluginManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
 #include "Misc/FileHelper.h"
 #include "Misc/PackageName.h"
 #include "Misc/PackagePath.h"
@@ -18,6 +30,14 @@ namespace
 	const FString GamePackageRoot = TEXT("/Game/");
 	const FString PluginsAuditPrefix = TEXT("_Plugins/");
 
+	/** Deflate cannot expand input by more than about 1032:1; a larger ISIZE is corrupt or hostile. */
+	constexpr int64 MaxDecompressionRatio = 1032;
+
+	/** Largest audit we will inflate, whatever the trailer claims. */
+	constexpr int64 MaxUncompressedAuditBytes = 256 * 1024 * 1024;
+
+	FThreadSafeCounter64 UnchangedCount;
+
 	FString ExtractMountName(const FString& PackageName)
 	{
 		// Package paths are /MountName/... ; pull out MountName.
@@ -189,22 +209,167 @@ FString FAuditFileUtils::PackageNameFromRelativeAuditPath(const FString& RelPath
 	return TEXT("/Game/") + RelPath;
 }
 
-bool FAuditFileUtils::DeleteAuditFile(const FString& FilePath)
+FString FAuditFileUtils::PackageNameFromAuditPath(const FString& AuditPath)
+{
+	const FString BaseDir = GetAuditBaseDir() + TEXT("/");
+
+	FString RelPath = AuditPath;
+	FPaths::NormalizeFilename(RelPath);
+	if (!RelPath.StartsWith(BaseDir))
+	{
+		return FString();
+	}
+	RelPath.RightChopInline(BaseDir.Len());
+	RelPath.RemoveFromEnd(CompressedSuffix);
+	RelPath.RemoveFromEnd(TEXT(".md"));
+	return PackageNameFromRelativeAuditPath(RelPath);
+}
+
+bool FAuditFileUtils::IsCompressionEnabled()
+{
+	static const bool bEnabled = GetDefault<UFathomAuditSettings>()->bCompressAuditFiles;
+	return bEnabled;
+}
+
+FString FAuditFileUtils::GetStoredAuditPath(const FString& AuditPath)
+{
+	return IsCompressionEnabled() ? AuditPath + CompressedSuffix : AuditPath;
+}
+
+FString FAuditFileUtils::FindStoredAuditPath(const FString& AuditPath)
 {
+	// Current storage mode first: after a switch, files migrate as they are rewritten
 	IFileManager& FM = IFileManager::Get();
-	if (!FM.FileExists(*FilePath))
+	const FString Preferred = GetStoredAuditPath(AuditPath);
+	if (FM.FileExists(*Preferred))
 	{
-		return true;
+		return Preferred;
 	}
 
-	if (FM.Delete(*FilePath))
+	const FString Other = IsCompressionEnabled() ? AuditPath : AuditPath + CompressedSuffix;
+	return FM.FileExists(*Other) ? Other : FString();
+}
+
+bool FAuditFileUtils::AuditFileExists(const FString& AuditPath)
+{
+	return !FindStoredAuditPath(AuditPath).IsEmpty();
+}
+
+bool FAuditFileUtils::LoadAuditFile(const FString& AuditPath, FString& OutContent)
+{
+	const FString StoredPath = FindStoredAuditPath(AuditPath);
+	if (StoredPath.IsEmpty())
 	{
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Deleted audit file %s"), *FilePath);
-		return true;
+		return false;
+	}
+
+	if (!StoredPath.EndsWith(CompressedSuffix))
+	{
+		return FFileHelper::LoadFileToString(OutContent, *StoredPath);
+	}
+
+	TArray<uint8> Compressed;
+	if (!FFileHelper::LoadFileToArray(Compressed, *StoredPath) || !DecompressAuditContent(Compressed, OutContent))
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Could not decompress %s"), *StoredPath);
+		return false;
+	}
+	return true;
+}
+
+void FAuditFileUtils::FindAuditFiles(const FString& Dir, TArray<FString>& OutFiles)
+{
+	IFileManager::Get().FindFilesRecursive(OutFiles, *Dir, TEXT("*.md"), true, false, /*bClearFileNames=*/ false);
+	IFileManager::Get().FindFilesRecursive(OutFiles, *Dir, TEXT("*.md.gz"), true, false, /*bClearFileNames=*/ false);
+}
+
+bool FAuditFileUtils::CompressAuditContent(const FString& Content, TArray<uint8>& OutCompressed)
+{
+	const FTCHARToUTF8 Utf8(*Content, Content.Len());
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Utf8.Length());
+	OutCompressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Gzip, OutCompressed.GetData(), CompressedSize, Utf8.Get(), Utf8.Length()))
+	{
+		OutCompressed.Reset();
+		return false;
+	}
+	OutCompressed.SetNum(CompressedSize, EAllowShrinking::No);
+	return true;
+}
+
+bool FAuditFileUtils::DecompressAuditContent(const TArray<uint8>& Compressed, FString& OutContent)
+{
+	// The gzip trailer ends with the uncompressed size (ISIZE, little-endian, mod 2^32)
+	if (Compressed.Num() < 18)
+	{
+		return false;
+	}
+	const uint8* Trailer = Compressed.GetData() + Compressed.Num() - 4;
+	const int32 UncompressedSize = static_cast<int32>(
+		Trailer[0] | (Trailer[1] << 8) | (Trailer[2] << 16) | (static_cast<uint32>(Trailer[3]) << 24));
+	// Cache files come from a share: cap the allocation before trusting the trailer
+	if (UncompressedSize < 0
+		|| UncompressedSize > static_cast<int64>(Compressed.Num()) * MaxDecompressionRatio
+		|| UncompressedSize > MaxUncompressedAuditBytes)
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Rejected compressed audit claiming %d byte(s) from %d"),
+			UncompressedSize, Compressed.Num());
+		return false;
 	}
 
-	UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to delete audit file %s"), *FilePath);
-	return false;
+	TArray<uint8> Utf8;
+	Utf8.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Gzip, Utf8.GetData(), UncompressedSize, Compressed.GetData(), Compressed.Num()))
+	{
+		return false;
+	}
+
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+	OutContent = FString(Converter.Length(), Converter.Get());
+	return true;
+}
+
+bool FAuditFileUtils::DeleteAuditFile(const FString& FilePath)
+{
+	// Sweeps pass the stored path, which may be the .md.gz
+	FString AuditPath = FilePath;
+	AuditPath.RemoveFromEnd(CompressedSuffix);
+	FAuditWriteQueue::Get().Cancel(AuditPath);
+	FAuditCompactBinary::DeleteSidecar(AuditPath);
+
+	const FString PackageName = PackageNameFromAuditPath(AuditPath);
+	if (!PackageName.IsEmpty())
+	{
+		if (FAuditIndex::IsEnabled())
+		{
+			FAuditIndex::Get().RecordDelete(PackageName);
+		}
+		if (FAuditPackStore::IsEnabled())
+		{
+			FAuditPackStore::Get().Remove(PackageName);
+		}
+	}
+
+	IFileManager& FM = IFileManager::Get();
+	bool bDeleted = true;
+	for (const FString& StoredPath : { AuditPath, AuditPath + CompressedSuffix })
+	{
+		if (!FM.FileExists(*StoredPath))
+		{
+			continue;
+		}
+
+		if (FM.Delete(*StoredPath))
+		{
+			UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Deleted audit file %s"), *StoredPath);
+		}
+		else
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to delete audit file %s"), *StoredPath);
+			bDeleted = false;
+		}
+	}
+	return bDeleted;
 }
 
 FString FAuditFileUtils::ToProjectRelativeSourcePath(const FString& AbsPath)
@@ -254,38 +419,261 @@ FString FAuditFileUtils::ComputeFileHash(const FString& FilePath)
 	return FString();
 }
 
-bool FAuditFileUtils::WriteAuditFile(const FString& Content, const FString& OutputPath)
+FString FAuditFileUtils::ReadStoredSourceHash(const FString& AuditPath)
 {
-	if (FFileHelper::SaveStringToFile(Content, *OutputPath))
+	FString FileContent;
+	if (!LoadAuditFile(AuditPath, FileContent))
 	{
-		UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Audit saved to %s"), *OutputPath);
-		return true;
+		return FString();
 	}
+	return ParseSourceHash(FileContent);
+}
 
-	UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Failed to write %s"), *OutputPath);
-	return false;
+FString FAuditFileUtils::ParseSourceHash(const FString& FileContent)
+{
+	const FString HashPrefix = TEXT("Hash: ");
+	int32 Pos = FileContent.Find(HashPrefix);
+	if (Pos == INDEX_NONE)
+	{
+		return FString();
+	}
+
+	Pos += HashPrefix.Len();
+	int32 EndPos = FileContent.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
+	if (EndPos == INDEX_NONE)
+	{
+		EndPos = FileContent.Len();
+	}
+	return FileContent.Mid(Pos, EndPos - Pos).TrimEnd();
 }
 
-void FAuditFileUtils::WriteAuditManifest()
+bool FAuditFileUtils::ParseAuditSchema(const FString& Content, FString& OutAuditor, int32& OutVersion)
 {
-	const FString VersionDir = FString::Printf(TEXT("v%d"), AuditSchemaVersion);
-	const FString AuditDir = FString::Printf(TEXT("Saved/Fathom/Audit/%s"), *VersionDir);
+	// Header only: the body may quote anything
+	int32 HeaderEnd = Content.Find(TEXT("\n\n"));
+	if (HeaderEnd == INDEX_NONE)
+	{
+		HeaderEnd = Content.Len();
+	}
 
-	const FString Json = FString::Printf(
-		TEXT("{\n  \"version\": %d,\n  \"auditDir\": \"%s\"\n}\n"),
-		AuditSchemaVersion, *AuditDir);
+	const FString SchemaPrefix = TEXT("\nAuditSchema: ");
+	int32 Pos = Content.Find(SchemaPrefix, ESearchCase::CaseSensitive, ESearchDir::FromStart, 0);
+	if (Pos == INDEX_NONE || Pos >= HeaderEnd)
+	{
+		return false;
+	}
+
+	Pos += SchemaPrefix.Len();
+	int32 EndPos = Content.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
+	if (EndPos == INDEX_NONE)
+	{
+		EndPos = Content.Len();
+	}
+
+	FString Version;
+	if (!Content.Mid(Pos, EndPos - Pos).TrimEnd().Split(TEXT("/"), &OutAuditor, &Version) || !Version.IsNumeric())
+	{
+		return false;
+	}
+	OutVersion = FCString::Atoi(*Version);
+	return true;
+}
+
+bool FAuditFileUtils::SetAuditSchema(FString& InOutContent, const FString& Auditor, int32 Version)
+{
+	const FString Schema = FString::Printf(TEXT("%s/%d"), *Auditor, Version);
 
-	const FString ManifestPath = FPaths::ConvertRelativePathToFull(
-		FPaths::ProjectDir() / TEXT("Saved") / TEXT("Fathom") / TEXT("audit-manifest.json"));
+	FString OldAuditor;
+	int32 OldVersion = 0;
+	if (ParseAuditSchema(InOutContent, OldAuditor, OldVersion))
+	{
+		TMap<FString, FString> Fields;
+		Fields.Add(TEXT("AuditSchema"), Schema);
+		return RewriteAuditHeader(InOutContent, FString(), Fields);
+	}
 
-	if (FFileHelper::SaveStringToFile(Json, *ManifestPath))
+	// Written before the line existed: it goes right after Hash
+	int32 HeaderEnd = InOutContent.Find(TEXT("\n\n"));
+	if (HeaderEnd == INDEX_NONE)
+	{
+		HeaderEnd = InOutContent.Len();
+	}
+	const int32 HashPos = InOutContent.Find(TEXT("\nHash: "));
+	if (HashPos == INDEX_NONE || HashPos >= HeaderEnd)
+	{
+		return false;
+	}
+	int32 LineEnd = InOutContent.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, HashPos + 1);
+	if (LineEnd == INDEX_NONE)
 	{
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Wrote audit manifest to %s"), *ManifestPath);
+		LineEnd = InOutContent.Len();
 	}
-	else
+	InOutContent.InsertAt(LineEnd, TEXT("\nAuditSchema: ") + Schema);
+	return true;
+}
+
+bool FAuditFileUtils::RewriteAuditHeader(FString& InOutContent, const FString& NewTitle, const TMap<FString, FString>& Fields)
+{
+	int32 HeaderEnd = InOutContent.Find(TEXT("\n\n"));
+	if (HeaderEnd == INDEX_NONE)
+	{
+		HeaderEnd = InOutContent.Len();
+	}
+
+	TArray<FString> HeaderLines;
+	InOutContent.Left(HeaderEnd).ParseIntoArrayLines(HeaderLines, /*InCullEmpty=*/ false);
+	if (HeaderLines.Num() == 0 || !HeaderLines[0].StartsWith(TEXT("# ")))
+	{
+		return false;
+	}
+
+	if (!NewTitle.IsEmpty())
+	{
+		HeaderLines[0] = TEXT("# ") + NewTitle;
+	}
+
+	for (int32 i = 1; i < HeaderLines.Num(); ++i)
+	{
+		FString Key;
+		FString Value;
+		if (HeaderLines[i].Split(TEXT(": "), &Key, &Value))
+		{
+			if (const FString* NewValue = Fields.Find(Key))
+			{
+				HeaderLines[i] = Key + TEXT(": ") + *NewValue;
+			}
+		}
+	}
+
+	InOutContent = FString::Join(HeaderLines, TEXT("\n")) + InOutContent.Mid(HeaderEnd);
+	return true;
+}
+
+EAuditMoveResult FAuditFileUtils::MoveAuditFile(const FString& OldPackageName, const FString& NewPackageName, const FString& NewObjectPath)
+{
+	const FString OldPath = GetAuditOutputPath(OldPackageName);
+	const FString NewPath = GetAuditOutputPath(NewPackageName);
+
+	// Either path may still have a write queued behind; the rest of the queue can wait
+	FAuditWriteQueue::Get().WaitForWrite(OldPath);
+	FAuditWriteQueue::Get().WaitForWrite(NewPath);
+
+	FString Content;
+	if (!LoadAuditFile(OldPath, Content))
 	{
-		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write audit manifest to %s"), *ManifestPath);
+		return EAuditMoveResult::NoSourceAudit;
 	}
+
+	// Audited at the new path already (saved before the move ran): keep the newer audit
+	if (AuditFileExists(NewPath))
+	{
+		DeleteAuditFile(OldPath);
+		return EAuditMoveResult::DestinationExists;
+	}
+
+	// Self references (own class path in graphs, variable types, ...) would be stale
+	// after a header-only patch
+	int32 BodyStart = Content.Find(TEXT("\n\n"));
+	if (BodyStart != INDEX_NONE && Content.Find(OldPackageName, ESearchCase::CaseSensitive, ESearchDir::FromStart, BodyStart) != INDEX_NONE)
+	{
+		DeleteAuditFile(OldPath);
+		return EAuditMoveResult::NeedsReAudit;
+	}
+
+	const FString NewSourcePath = GetSourceFilePath(NewPackageName);
+	TMap<FString, FString> Fields;
+	Fields.Add(TEXT("Path"), NewObjectPath);
+	Fields.Add(TEXT("SourcePath"), ToProjectRelativeSourcePath(NewSourcePath));
+	const FString NewHash = ComputeFileHash(NewSourcePath);
+	if (!NewHash.IsEmpty())
+	{
+		Fields.Add(TEXT("Hash"), NewHash);
+	}
+
+	if (!RewriteAuditHeader(Content, FPackageName::GetShortName(NewPackageName), Fields))
+	{
+		DeleteAuditFile(OldPath);
+		return EAuditMoveResult::Failed;
+	}
+
+	// The old audit is the only copy until the new one is on disk
+	if (!WriteAuditFile(Content, NewPath) || !FAuditWriteQueue::Get().WaitForWrite(NewPath))
+	{
+		return EAuditMoveResult::Failed;
+	}
+
+	IFileManager::Get().Delete(*OldPath);
+	IFileManager::Get().Delete(*(OldPath + CompressedSuffix));
+	FAuditCompactBinary::DeleteSidecar(OldPath);
+	if (FAuditIndex::IsEnabled())
+	{
+		FAuditIndex::Get().RecordDelete(OldPackageName);
+	}
+	if (FAuditPackStore::IsEnabled())
+	{
+		FAuditPackStore::Get().Remove(OldPackageName);
+	}
+	return EAuditMoveResult::Moved;
+}
+
+bool FAuditFileUtils::WriteAuditFile(const FString& Content, const FString& OutputPath, bool bMigration)
+{
+	const FString PackageName = PackageNameFromAuditPath(OutputPath);
+
+	// Large audits carry a section table so readers can fetch one graph by offset
+	FString IndexedContent = Content;
+	FAuditSectionIndex::Attach(IndexedContent);
+	const FString OutputHash = HashAuditContent(IndexedContent);
+
+	// Same bytes as last time (dependency-triggered re-audit, no-op resave): leave the
+	// file alone so Rider's watchers and Fathom's re-indexing stay quiet
+	if (!FAuditWriteQueue::Get().Enqueue(OutputPath, PackageName, IndexedContent, OutputHash, bMigration))
+	{
+		UnchangedCount.Increment();
+		UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Audit unchanged, skipped write of %s"), *OutputPath);
+	}
+
+	// Unchanged audits too: the first publishing run on a machine fills the cache from its tree
+	FAuditCache::Get().Store(IndexedContent);
+	return true;
+}
+
+bool FAuditFileUtils::WriteAuditFileIfMissing(const FString& Content, const FString& OutputPath)
+{
+	FString IndexedContent = Content;
+	FAuditSectionIndex::Attach(IndexedContent);
+	return FAuditWriteQueue::Get().EnqueueIfAbsent(OutputPath, PackageNameFromAuditPath(OutputPath),
+		IndexedContent, HashAuditContent(IndexedContent));
+}
+
+FString FAuditFileUtils::HashAuditContent(const FString& Content)
+{
+	const FXxHash64 Hash = FXxHash64::HashBuffer(*Content, Content.Len() * sizeof(TCHAR));
+	return FString::Printf(TEXT("%016llx"), Hash.Hash);
+}
+
+FAuditWriteStats FAuditFileUtils::GetWriteStats()
+{
+	FAuditWriteStats Stats;
+	Stats.Written = FAuditWriteQueue::Get().GetNumWritten();
+	Stats.Failed = FAuditWriteQueue::Get().GetNumFailed();
+	Stats.Migrated = FAuditMigrationRegistry::Get().GetNumMigrated();
+	Stats.Cached = FAuditCache::Get().GetStats().Hits;
+	Stats.Unchanged = UnchangedCount.GetValue();
+	return Stats;
+}
+
+void FAuditFileUtils::WriteAuditManifest()
+{
+	FAuditWriteQueue::Get().Flush();
+
+	if (!FAuditIndex::IsEnabled())
+	{
+		return;
+	}
+
+	FAuditIndex::Get().Flush(/*bForce=*/ true);
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Wrote audit manifest to %s"), *FAuditIndex::GetManifestPath());
 }
 
 bool FAuditFileUtils::IsSupportedBlueprintClass(const FTopLevelAssetPath& ClassPath)
@@ -0,0 +1,488 @@
+#include "Audit/AuditIndex.h"
+
+#include "Audit/AuditAssetUtils.h"
+#include "Audit/AuditFileUtils.h"
+#include "Audit/AuditThreadPool.h"
+#include "FathomAuditSettings.h"
+#include "FathomUELinkModule.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	/** Asset class short name (Blueprint, WidgetBlueprint, DataTable, ...) from the registry. */
+	FString LookUpAssetType(const FString& PackageName)
+	{
+		IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+		if (!AssetRegistry)
+		{
+			return FString();
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry->GetAssetsByPackageName(FName(*PackageName), Assets, /*bIncludeOnlyOnDiskAssets=*/ true);
+		if (Assets.IsEmpty())
+		{
+			return FString();
+		}
+
+		const FString ShortName = FPackageName::GetShortName(PackageName);
+		const FAssetData* Primary = Assets.FindByPredicate([&ShortName](const FAssetData& Asset)
+		{
+			return Asset.AssetName.ToString() == ShortName;
+		});
+		return (Primary ? *Primary : Assets[0]).AssetClassPath.GetAssetName().ToString();
+	}
+
+	FString FormatSchema(const FString& Content)
+	{
+		FString Auditor;
+		int32 Version = 0;
+		return FAuditFileUtils::ParseAuditSchema(Content, Auditor, Version)
+			? FString::Printf(TEXT("%s/%d"), *Auditor, Version) : FString();
+	}
+
+	/** How long a flush waits for another process to finish writing the manifest. */
+	constexpr double ManifestLockTimeoutSeconds = 5.0;
+
+	/**
+	 * Holds <manifest>.lock open for writing, which no other process can do at the same
+	 * time (exclusive share mode on Windows, flock elsewhere). Serializes manifest
+	 * writers across the editor, the daemon and commandlet runs.
+	 */
+	class FScopedManifestLock
+	{
+	public:
+		FScopedManifestLock()
+		{
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			const FString LockPath = FAuditIndex::GetManifestPath() + TEXT(".lock");
+			const double Deadline = FPlatformTime::Seconds() + ManifestLockTimeoutSeconds;
+			while (true)
+			{
+				Handle.Reset(PlatformFile.OpenWrite(*LockPath));
+				if (Handle || FPlatformTime::Seconds() >= Deadline)
+				{
+					break;
+				}
+				FPlatformProcess::SleepNoStats(0.01f);
+			}
+		}
+
+		bool IsLocked() const { return Handle.IsValid(); }
+
+	private:
+		TUniquePtr<IFileHandle> Handle;
+	};
+
+	/** Id of the last manifest write by any process, from <manifest>.stamp. */
+	FString GetStampPath()
+	{
+		return FAuditIndex::GetManifestPath() + TEXT(".stamp");
+	}
+
+	/**
+	 * Parse the manifest's assets. False if it is missing, unreadable or written for
+	 * another schema version. bOutComplete is false while an index rebuild is unfinished.
+	 */
+	bool ReadManifest(TMap<FString, FAuditIndex::FEntry>& OutEntries, bool& bOutComplete)
+	{
+		FString Json;
+		if (!FFileHelper::LoadFileToString(Json, *FAuditIndex::GetManifestPath()))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Could not parse %s, rebuilding the audit index"), *FAuditIndex::GetManifestPath());
+			return false;
+		}
+
+		// Written for another schema version: those audits live in another directory
+		int32 Version = 0;
+		const TSharedPtr<FJsonObject>* Assets = nullptr;
+		if (!Root->TryGetNumberField(TEXT("version"), Version) || Version != FAuditFileUtils::AuditSchemaVersion
+			|| !Root->TryGetObjectField(TEXT("assets"), Assets))
+		{
+			return false;
+		}
+
+		// Manifests from before the flag were only written once complete
+		bOutComplete = true;
+		Root->TryGetBoolField(TEXT("indexComplete"), bOutComplete);
+
+		OutEntries.Reserve((*Assets)->Values.Num());
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Assets)->Values)
+		{
+			const TSharedPtr<FJsonObject>* AssetJson = nullptr;
+			if (!Pair.Value.IsValid() || !Pair.Value->TryGetObject(AssetJson))
+			{
+				continue;
+			}
+
+			FAuditIndex::FEntry& Entry = OutEntries.Add(Pair.Key);
+			(*AssetJson)->TryGetStringField(TEXT("type"), Entry.AssetType);
+			(*AssetJson)->TryGetStringField(TEXT("path"), Entry.AuditPath);
+			(*AssetJson)->TryGetStringField(TEXT("hash"), Entry.SourceHash);
+			(*AssetJson)->TryGetStringField(TEXT("schema"), Entry.Schema);
+			(*AssetJson)->TryGetStringField(TEXT("outputHash"), Entry.OutputHash);
+			(*AssetJson)->TryGetNumberField(TEXT("size"), Entry.OutputSize);
+
+			FString AuditedAt;
+			if ((*AssetJson)->TryGetStringField(TEXT("auditedAt"), AuditedAt))
+			{
+				FDateTime::ParseIso8601(*AuditedAt, Entry.AuditedAt);
+			}
+		}
+		return true;
+	}
+
+	FString MakeRelativeAuditPath(const FString& OutputPath)
+	{
+		const FString BaseDir = FAuditFileUtils::GetAuditBaseDir() + TEXT("/");
+		FString RelPath = OutputPath;
+		FPaths::NormalizeFilename(RelPath);
+		RelPath.RemoveFromStart(BaseDir);
+		return RelPath;
+	}
+}
+
+FAuditIndex& FAuditIndex::Get()
+{
+	static FAuditIndex Instance;
+	return Instance;
+}
+
+bool FAuditIndex::IsEnabled()
+{
+	static const bool bEnabled = !FParse::Param(FCommandLine::Get(), TEXT("FathomAuditChild"));
+	return bEnabled;
+}
+
+FString FAuditIndex::GetManifestPath()
+{
+	return FPaths::ConvertRelativePathToFull(
+		FPaths::ProjectDir() / TEXT("Saved") / TEXT("Fathom") / TEXT("audit-manifest.json"));
+}
+
+void FAuditIndex::RecordWrite(const FString& PackageName, const FString& OutputPath, const FString& Content, const FString& OutputHash)
+{
+	FEntry Entry;
+	Entry.AssetType = LookUpAssetType(PackageName);
+	Entry.AuditPath = MakeRelativeAuditPath(OutputPath);
+	Entry.SourceHash = FAuditFileUtils::ParseSourceHash(Content);
+	Entry.Schema = FormatSchema(Content);
+	Entry.OutputHash = OutputHash;
+	Entry.OutputSize = IFileManager::Get().FileSize(*OutputPath);
+	Entry.AuditedAt = FDateTime::UtcNow();
+
+	bool bFlush = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		LoadLocked();
+		Entries.Add(PackageName, MoveTemp(Entry));
+		DirtyKeys.Add(PackageName);
+		bFlush = ++UnflushedChanges >= FlushBatchSize;
+	}
+
+	if (bFlush)
+	{
+		Flush();
+	}
+}
+
+FString FAuditIndex::GetOutputHash(const FString& PackageName)
+{
+	FScopeLock ScopeLock(&Lock);
+	LoadLocked();
+	const FEntry* Entry = Entries.Find(PackageName);
+	return Entry ? Entry->OutputHash : FString();
+}
+
+void FAuditIndex::RecordDelete(const FString& PackageName)
+{
+	bool bFlush = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		LoadLocked();
+		if (Entries.Remove(PackageName) == 0)
+		{
+			return;
+		}
+		DirtyKeys.Add(PackageName);
+		bFlush = ++UnflushedChanges >= FlushBatchSize;
+	}
+
+	if (bFlush)
+	{
+		Flush();
+	}
+}
+
+void FAuditIndex::RecordFromFiles(const TArray<FString>& PackageNames, const FAuditCancellationToken* CancelToken)
+{
+	TArray<FString> Names = PackageNames;
+	if (Names.IsEmpty())
+	{
+		TArray<FString> AuditFiles;
+		FAuditFileUtils::FindAuditFiles(FAuditFileUtils::GetAuditBaseDir(), AuditFiles);
+		for (const FString& AuditFile : AuditFiles)
+		{
+			FString PackageName = FAuditFileUtils::PackageNameFromAuditPath(AuditFile);
+			if (!PackageName.IsEmpty())
+			{
+				Names.Add(MoveTemp(PackageName));
+			}
+		}
+	}
+
+	for (const FString& PackageName : Names)
+	{
+		// A partial walk leaves the rebuild flag set, so the next launch walks again
+		if (CancelToken && CancelToken->IsCanceled())
+		{
+			return;
+		}
+
+		const FString OutputPath = FAuditFileUtils::GetAuditOutputPath(PackageName);
+		const FString AuditPath = FAuditFileUtils::FindStoredAuditPath(OutputPath);
+		FString Content;
+		if (AuditPath.IsEmpty() || !FAuditFileUtils::LoadAuditFile(OutputPath, Content))
+		{
+			RecordDelete(PackageName);
+			continue;
+		}
+
+		FEntry Entry;
+		Entry.AssetType = LookUpAssetType(PackageName);
+		Entry.AuditPath = MakeRelativeAuditPath(AuditPath);
+		Entry.SourceHash = FAuditFileUtils::ParseSourceHash(Content);
+		Entry.Schema = FormatSchema(Content);
+		Entry.OutputHash = FAuditFileUtils::HashAuditContent(Content);
+		Entry.OutputSize = IFileManager::Get().FileSize(*AuditPath);
+		Entry.AuditedAt = IFileManager::Get().GetTimeStamp(*AuditPath);
+
+		FScopeLock ScopeLock(&Lock);
+		LoadLocked();
+		Entries.Add(PackageName, MoveTemp(Entry));
+		DirtyKeys.Add(PackageName);
+		++UnflushedChanges;
+	}
+
+	// Only a walk of the whole tree completes a rebuild
+	if (PackageNames.IsEmpty())
+	{
+		FScopeLock ScopeLock(&Lock);
+		bNeedsRebuild = false;
+		++UnflushedChanges;
+	}
+	Flush();
+}
+
+bool FAuditIndex::NeedsRebuild()
+{
+	FScopeLock ScopeLock(&Lock);
+	LoadLocked();
+	return bNeedsRebuild;
+}
+
+bool FAuditIndex::IsDirty()
+{
+	FScopeLock ScopeLock(&Lock);
+	return UnflushedChanges > 0;
+}
+
+void FAuditIndex::Flush(bool bForce)
+{
+	// FlushLock keeps an older snapshot from landing on top of a newer one
+	FScopeLock FlushScopeLock(&FlushLock);
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (UnflushedChanges == 0 && !bForce)
+		{
+			return;
+		}
+	}
+
+	// A commandlet or the daemon may write the manifest beside the editor. Writers take
+	// turns, and each folds in what the others wrote since its last flush.
+	const FScopedManifestLock ProcessLock;
+	if (!ProcessLock.IsLocked())
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Audit manifest is locked by another process, flush deferred"));
+		return;
+	}
+
+	FString DiskStamp;
+	FFileHelper::LoadFileToString(DiskStamp, *GetStampPath());
+	TMap<FString, FEntry> DiskEntries;
+	bool bDiskComplete = false;
+	const bool bMerge = !DiskStamp.IsEmpty() && DiskStamp != SyncedStamp && ReadManifest(DiskEntries, bDiskComplete);
+
+	FString Json;
+	int32 NumEntries = 0;
+	TSet<FString> FlushedKeys;
+	{
+		FScopeLock ScopeLock(&Lock);
+		LoadLocked();
+		if (bMerge)
+		{
+			MergeLocked(MoveTemp(DiskEntries), bDiskComplete);
+		}
+		Json = SerializeLocked();
+		NumEntries = Entries.Num();
+		FlushedKeys = MoveTemp(DirtyKeys);
+		DirtyKeys.Reset();
+		UnflushedChanges = 0;
+	}
+
+	const FString ManifestPath = GetManifestPath();
+	const FString TempPath = ManifestPath + TEXT(".tmp");
+	const FString NewStamp = FGuid::NewGuid().ToString();
+	if (!FFileHelper::SaveStringToFile(Json, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*ManifestPath, *TempPath, /*Replace=*/ true))
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write audit manifest to %s"), *ManifestPath);
+		IFileManager::Get().Delete(*TempPath);
+
+		FScopeLock ScopeLock(&Lock);
+		DirtyKeys.Append(FlushedKeys);
+		UnflushedChanges = FMath::Max(UnflushedChanges, 1);
+		return;
+	}
+
+	FFileHelper::SaveStringToFile(NewStamp, *GetStampPath());
+	SyncedStamp = NewStamp;
+	UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Wrote audit manifest (%d assets) to %s"), NumEntries, *ManifestPath);
+}
+
+void FAuditIndex::MergeLocked(TMap<FString, FEntry>&& DiskEntries, bool bDiskComplete)
+{
+	// An unfinished index on disk lacks assets this process knows about
+	if (!bDiskComplete)
+	{
+		for (const TPair<FString, FEntry>& Pair : Entries)
+		{
+			if (!DiskEntries.Contains(Pair.Key))
+			{
+				DiskEntries.Add(Pair.Key, Pair.Value);
+			}
+		}
+	}
+
+	// This process's writes and deletes since its last flush win
+	for (const FString& PackageName : DirtyKeys)
+	{
+		if (const FEntry* Entry = Entries.Find(PackageName))
+		{
+			DiskEntries.Add(PackageName, *Entry);
+		}
+		else
+		{
+			DiskEntries.Remove(PackageName);
+		}
+	}
+
+	Entries = MoveTemp(DiskEntries);
+	bNeedsRebuild = bNeedsRebuild && !bDiskComplete;
+}
+
+void FAuditIndex::LoadLocked()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	bool bComplete = false;
+	if (!ReadManifest(Entries, bComplete))
+	{
+		Entries.Reset();
+	}
+	bNeedsRebuild = !bComplete;
+}
+
+FString FAuditIndex::SerializeLocked() const
+{
+	const FString AuditDir = FString::Printf(TEXT("Saved/Fathom/Audit/v%d"), FAuditFileUtils::AuditSchemaVersion);
+
+	TArray<FString> PackageNames;
+	Entries.GetKeys(PackageNames);
+	PackageNames.Sort();
+
+	FString Json;
+	Json.Reserve(128 + PackageNames.Num() * 192);
+
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("version"), FAuditFileUtils::AuditSchemaVersion);
+	Writer->WriteValue(TEXT("auditDir"), AuditDir);
+	// The setting, not IsEnabled: commandlets sharing the manifest leave the editor's pack alone
+	if (GetDefault<UFathomAuditSettings>()->bPackedAuditStore)
+	{
+		Writer->WriteValue(TEXT("packFile"), AuditDir / TEXT("audit.pack"));
+		Writer->WriteValue(TEXT("packIndex"), AuditDir / TEXT("audit.pack.idx"));
+	}
+	Writer->WriteValue(TEXT("assetCount"), PackageNames.Num());
+	Writer->WriteValue(TEXT("indexComplete"), !bNeedsRebuild);
+
+	// Current auditor versions; an asset whose "schema" differs is due for a re-audit
+	Writer->WriteObjectStart(TEXT("schemas"));
+	TMap<FString, int32> SchemaVersions = FAuditAssetUtils::GetSchemaVersions();
+	SchemaVersions.KeySort(TLess<FString>());
+	for (const TPair<FString, int32>& Pair : SchemaVersions)
+	{
+		Writer->WriteValue(Pair.Key, Pair.Value);
+	}
+	Writer->WriteObjectEnd();
+
+	Writer->WriteObjectStart(TEXT("assets"));
+	for (const FString& PackageName : PackageNames)
+	{
+		const FEntry& Entry = Entries.FindChecked(PackageName);
+		Writer->WriteObjectStart(PackageName);
+		Writer->WriteValue(TEXT("type"), Entry.AssetType);
+		Writer->WriteValue(TEXT("path"), Entry.AuditPath);
+		if (!Entry.SourceHash.IsEmpty())
+		{
+			Writer->WriteValue(TEXT("hash"), Entry.SourceHash);
+		}
+		if (!Entry.Schema.IsEmpty())
+		{
+			Writer->WriteValue(TEXT("schema"), Entry.Schema);
+		}
+		if (!Entry.OutputHash.IsEmpty())
+		{
+			Writer->WriteValue(TEXT("outputHash"), Entry.OutputHash);
+		}
+		Writer->WriteValue(TEXT("size"), Entry.OutputSize);
+		Writer->WriteValue(TEXT("auditedAt"), Entry.AuditedAt.ToIso8601());
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteObjectEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Json;
+}
@@ -0,0 +1,212 @@
+#include "Audit/AuditJournal.h"
+
+#include "Audit/AuditFileUtils.h"
+#include "FathomUELinkModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	const FString TotalPrefix = TEXT("total ");
+	const FString BeginPrefix = TEXT("begin ");
+	const FString DonePrefix = TEXT("done ");
+	const FString FailedPrefix = TEXT("failed ");
+	const FString QuarantinePrefix = TEXT("quarantine ");
+	const FString EndMarker = TEXT("end");
+}
+
+FAuditJournal::~FAuditJournal()
+{
+	// Closing without Finish() leaves no "end" marker, which is what a supervisor
+	// sees after a crash as well
+	Writer.Reset();
+}
+
+void FAuditJournal::Open(const FString& Path, bool bResume)
+{
+	TArray<FString> QuarantineLines;
+	FFileHelper::LoadFileToStringArray(QuarantineLines, *GetQuarantinePath());
+	for (const FString& Line : QuarantineLines)
+	{
+		FString PackageName;
+		FString SourceHash;
+		if (Line.Split(TEXT("\t"), &PackageName, &SourceHash))
+		{
+			Quarantined.Add(PackageName, SourceHash);
+		}
+	}
+
+	if (Path.IsEmpty())
+	{
+		return;
+	}
+
+	FString InFlightPackage;
+	if (bResume)
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *Path);
+		for (const FString& Line : Lines)
+		{
+			if (Line.StartsWith(DonePrefix))
+			{
+				Completed.Add(Line.RightChop(DonePrefix.Len()));
+			}
+			else if (Line.StartsWith(FailedPrefix))
+			{
+				Completed.Add(Line.RightChop(FailedPrefix.Len()));
+			}
+		}
+		InFlightPackage = ReadSummary(Path).InFlightPackage;
+	}
+
+	const uint32 WriteFlags = bResume ? (FILEWRITE_Append | FILEWRITE_AllowRead) : FILEWRITE_AllowRead;
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Path, WriteFlags));
+	if (!Writer)
+	{
+		UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Failed to open audit journal %s"), *Path);
+		return;
+	}
+
+	if (bResume)
+	{
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Resuming from %s, %d package(s) already done"), *Path, Completed.Num());
+	}
+
+	if (!InFlightPackage.IsEmpty())
+	{
+		Quarantine(InFlightPackage);
+	}
+}
+
+void FAuditJournal::Finish()
+{
+	if (Writer)
+	{
+		WriteLine(EndMarker);
+		Writer.Reset();
+	}
+}
+
+void FAuditJournal::RecordTotal(int32 Total)
+{
+	WriteLine(TotalPrefix + LexToString(Total));
+}
+
+void FAuditJournal::BeginEntry(const FString& PackageName)
+{
+	WriteLine(BeginPrefix + PackageName);
+}
+
+void FAuditJournal::CompleteEntry(const FString& PackageName, bool bWritten)
+{
+	WriteLine((bWritten ? DonePrefix : FailedPrefix) + PackageName);
+}
+
+bool FAuditJournal::IsCompleted(const FString& PackageName) const
+{
+	return Completed.Contains(PackageName);
+}
+
+bool FAuditJournal::IsQuarantined(const FString& PackageName, const FString& SourcePath) const
+{
+	const FString* QuarantinedHash = Quarantined.Find(PackageName);
+	if (!QuarantinedHash)
+	{
+		return false;
+	}
+
+	// An edited asset gets another chance
+	return QuarantinedHash->IsEmpty() || *QuarantinedHash == FAuditFileUtils::ComputeFileHash(SourcePath);
+}
+
+FAuditJournal::FSummary FAuditJournal::ReadSummary(const FString& Path)
+{
+	FSummary Summary;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		return Summary;
+	}
+
+	TSet<FString> Done;
+	TSet<FString> Failed;
+	for (const FString& Line : Lines)
+	{
+		if (Line.StartsWith(TotalPrefix))
+		{
+			LexFromString(Summary.Total, *Line.RightChop(TotalPrefix.Len()));
+		}
+		else if (Line.StartsWith(BeginPrefix))
+		{
+			Summary.InFlightPackage = Line.RightChop(BeginPrefix.Len());
+		}
+		else if (Line.StartsWith(DonePrefix))
+		{
+			const FString PackageName = Line.RightChop(DonePrefix.Len());
+			Done.Add(PackageName);
+			Failed.Remove(PackageName);
+			Summary.InFlightPackage.Reset();
+		}
+		else if (Line.StartsWith(FailedPrefix))
+		{
+			const FString PackageName = Line.RightChop(FailedPrefix.Len());
+			if (!Done.Contains(PackageName))
+			{
+				Failed.Add(PackageName);
+			}
+			Summary.InFlightPackage.Reset();
+		}
+		else if (Line.StartsWith(QuarantinePrefix))
+		{
+			++Summary.Quarantined;
+			Summary.InFlightPackage.Reset();
+		}
+		else if (Line == EndMarker)
+		{
+			Summary.bFinished = true;
+		}
+	}
+
+	Summary.Completed = Done.Num() + Failed.Num();
+	Summary.Failed = Failed.Num();
+	return Summary;
+}
+
+FString FAuditJournal::GetDefaultJournalPath()
+{
+	return FPaths::ConvertRelativePathToFull(
+		FPaths::ProjectDir() / TEXT("Saved") / TEXT("Fathom") / TEXT("audit-journal.txt"));
+}
+
+FString FAuditJournal::GetQuarantinePath()
+{
+	return FPaths::ConvertRelativePathToFull(
+		FPaths::ProjectDir() / TEXT("Saved") / TEXT("Fathom") / TEXT("audit-quarantine.txt"));
+}
+
+void FAuditJournal::WriteLine(const FString& Line)
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	FTCHARToUTF8 Utf8(*(Line + TEXT("\n")));
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+	Writer->Flush();
+}
+
+void FAuditJournal::Quarantine(const FString& PackageName)
+{
+	const FString SourceHash = FAuditFileUtils::ComputeFileHash(FAuditFileUtils::GetSourceFilePath(PackageName));
+	Quarantined.Add(PackageName, SourceHash);
+	WriteLine(QuarantinePrefix + PackageName);
+
+	FFileHelper::SaveStringToFile(PackageName + TEXT("\t") + SourceHash + TEXT("\n"), *GetQuarantinePath(),
+		FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+
+	UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Quarantined %s: the previous run crashed while auditing it"), *PackageName);
+}
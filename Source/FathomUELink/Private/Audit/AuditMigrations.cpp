@@ -0,0 +1,124 @@
+#include "Audit/AuditMigrations.h"
+
+#include "Audit/AuditFileUtils.h"
+#include "Misc/ScopeRWLock.h"
+
+FAuditMigrationRegistry& FAuditMigrationRegistry::Get()
+{
+	static FAuditMigrationRegistry Instance;
+	return Instance;
+}
+
+FString FAuditMigrationRegistry::MakeKey(const FString& Auditor, int32 FromVersion)
+{
+	return FString::Printf(TEXT("%s/%d"), *Auditor, FromVersion);
+}
+
+void FAuditMigrationRegistry::RegisterMigration(const FString& Auditor, int32 FromVersion, FMigration&& Migration)
+{
+	FWriteScopeLock ScopeLock(MigrationsLock);
+	Migrations.Add(MakeKey(Auditor, FromVersion), MoveTemp(Migration));
+}
+
+void FAuditMigrationRegistry::UnregisterMigrations(const FString& Auditor)
+{
+	const FString Prefix = Auditor + TEXT("/");
+	FWriteScopeLock ScopeLock(MigrationsLock);
+	for (auto It = Migrations.CreateIterator(); It; ++It)
+	{
+		if (It.Key().StartsWith(Prefix, ESearchCase::CaseSensitive))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FAuditMigrationRegistry::Migrate(const FString& Auditor, int32 FromVersion, int32 ToVersion, FString& InOutContent) const
+{
+	if (FromVersion >= ToVersion)
+	{
+		return false;
+	}
+
+	FString Content = InOutContent;
+	{
+		// Held across the steps: an unloading module must not free one mid-call
+		FReadScopeLock ScopeLock(MigrationsLock);
+		for (int32 Version = FromVersion; Version < ToVersion; ++Version)
+		{
+			const FMigration* Migration = Migrations.Find(MakeKey(Auditor, Version));
+			if (!Migration || !(*Migration)(Content))
+			{
+				return false;
+			}
+		}
+	}
+
+	if (!FAuditFileUtils::SetAuditSchema(Content, Auditor, ToVersion))
+	{
+		return false;
+	}
+	InOutContent = MoveTemp(Content);
+	return true;
+}
+
+bool FAuditMigrationRegistry::CanMigrate(const FString& Auditor, int32 FromVersion, int32 ToVersion) const
+{
+	if (FromVersion >= ToVersion)
+	{
+		return false;
+	}
+
+	FReadScopeLock ScopeLock(MigrationsLock);
+	for (int32 Version = FromVersion; Version < ToVersion; ++Version)
+	{
+		if (!Migrations.Contains(MakeKey(Auditor, Version)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FAuditMigrationRegistry::FindSection(const FString& Content, const FString& Heading, int32& OutStart, int32& OutEnd)
+{
+	const FString HeadingLine = TEXT("\n## ") + Heading + TEXT("\n");
+	const int32 Found = Content.Find(HeadingLine, ESearchCase::CaseSensitive);
+	if (Found == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutStart = Found + 1;
+	OutEnd = Content.Find(TEXT("\n## "), ESearchCase::CaseSensitive, ESearchDir::FromStart, OutStart);
+	OutEnd = OutEnd == INDEX_NONE ? Content.Len() : OutEnd + 1;
+	return true;
+}
+
+bool FAuditMigrationRegistry::ReplaceSection(FString& InOutContent, const FString& Heading, const FString& NewSection)
+{
+	int32 Start, End;
+	if (!FindSection(InOutContent, Heading, Start, End))
+	{
+		return false;
+	}
+	InOutContent = InOutContent.Left(Start) + NewSection + InOutContent.Mid(End);
+	return true;
+}
+
+bool FAuditMigrationRegistry::RemoveSection(FString& InOutContent, const FString& Heading)
+{
+	return ReplaceSection(InOutContent, Heading, FString());
+}
+
+bool FAuditMigrationRegistry::RenameSection(FString& InOutContent, const FString& Heading, const FString& NewHeading)
+{
+	int32 Start, End;
+	if (!FindSection(InOutContent, Heading, Start, End))
+	{
+		return false;
+	}
+	const int32 HeadingLen = 3 + Heading.Len();  // "## " + Heading
+	InOutContent = InOutContent.Left(Start) + TEXT("## ") + NewHeading + InOutContent.Mid(Start + HeadingLen);
+	return true;
+}
@@ -0,0 +1,694 @@
+#include "Audit/AuditPackStore.h"
+
+#include "Audit/AuditFileUtils.h"
+#include "Audit/AuditThreadPool.h"
+#include "FathomAuditSettings.h"
+#include "FathomUELinkModule.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	FString Utf8ToString(const void* Bytes, int32 NumBytes)
+	{
+		const FUTF8ToTCHAR Converted(static_cast<const ANSICHAR*>(Bytes), NumBytes);
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	void SerializeBytes(FArchive& Ar, const void* Bytes, int64 NumBytes)
+	{
+		Ar.Serialize(const_cast<void*>(Bytes), NumBytes);
+	}
+
+	/** Ordinal order, so readers can binary-search the index on the raw UTF-8 keys. */
+	void SortKeys(TArray<FString>& Keys)
+	{
+		Keys.Sort([](const FString& A, const FString& B)
+		{
+			return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+		});
+	}
+}
+
+FAuditPackStore& FAuditPackStore::Get()
+{
+	static FAuditPackStore Instance;
+	return Instance;
+}
+
+FAuditPackStore::FAuditPackStore() = default;
+FAuditPackStore::~FAuditPackStore() = default;
+
+bool FAuditPackStore::IsEnabled()
+{
+	// Appends take their offsets from this process's view of the file, so only one
+	// process may own the pack: the editor. Commandlets (the offloaded child, -Daemon,
+	// -ChangedFiles, CI) running beside it would interleave records with it.
+	static const bool bEnabled = GetDefault<UFathomAuditSettings>()->bPackedAuditStore
+		&& !IsRunningCommandlet();
+	return bEnabled;
+}
+
+FString FAuditPackStore::GetPackPath()
+{
+	return FAuditFileUtils::GetAuditBaseDir() / TEXT("audit.pack");
+}
+
+FString FAuditPackStore::GetIndexPath()
+{
+	return GetPackPath() + TEXT(".idx");
+}
+
+bool FAuditPackStore::Write(const FString& PackageName, const FString& Content)
+{
+	FScopeLock ScopeLock(&Lock);
+	const FRecordRef Record{ &PackageName, &Content };
+	return OpenLocked() && AppendLocked(MakeArrayView(&Record, 1));
+}
+
+bool FAuditPackStore::WriteMany(const TMap<FString, FString>& Contents)
+{
+	TArray<FRecordRef> Records;
+	Records.Reserve(Contents.Num());
+	for (const TPair<FString, FString>& Pair : Contents)
+	{
+		Records.Add({ &Pair.Key, &Pair.Value });
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	return OpenLocked() && AppendLocked(Records);
+}
+
+bool FAuditPackStore::Remove(const FString& PackageName)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked() || !Entries.Contains(PackageName))
+	{
+		return false;
+	}
+	const FRecordRef Record{ &PackageName, nullptr };
+	return AppendLocked(MakeArrayView(&Record, 1));
+}
+
+bool FAuditPackStore::Read(const FString& PackageName, FString& OutContent)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked())
+	{
+		return false;
+	}
+
+	const FEntry* Entry = Entries.Find(PackageName);
+	if (!Entry || !MapLocked())
+	{
+		return false;
+	}
+
+	OutContent = Utf8ToString(MappedRegion->GetMappedPtr() + Entry->DataOffset, Entry->DataSize);
+	return true;
+}
+
+int32 FAuditPackStore::ReadMany(const TArray<FString>& PackageNames, TMap<FString, FString>& OutContents)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked() || !MapLocked())
+	{
+		return 0;
+	}
+
+	int32 Found = 0;
+	for (const FString& PackageName : PackageNames)
+	{
+		if (const FEntry* Entry = Entries.Find(PackageName))
+		{
+			OutContents.Add(PackageName, Utf8ToString(MappedRegion->GetMappedPtr() + Entry->DataOffset, Entry->DataSize));
+			++Found;
+		}
+	}
+	return Found;
+}
+
+int32 FAuditPackStore::ImportFromFiles(const TArray<FString>& PackageNames, bool bOverwrite,
+	const FAuditCancellationToken* CancelToken)
+{
+	TArray<FString> Names = PackageNames;
+	if (Names.IsEmpty())
+	{
+		TArray<FString> AuditFiles;
+		FAuditFileUtils::FindAuditFiles(FAuditFileUtils::GetAuditBaseDir(), AuditFiles);
+		for (const FString& AuditFile : AuditFiles)
+		{
+			FString PackageName = FAuditFileUtils::PackageNameFromAuditPath(AuditFile);
+			if (!PackageName.IsEmpty())
+			{
+				Names.Add(MoveTemp(PackageName));
+			}
+		}
+	}
+
+	int32 Written = 0;
+	TMap<FString, FString> Contents;
+	TArray<FString> Gone;
+
+	// Files are read outside the lock so audit writes on other threads are not held up,
+	// then appended a chunk at a time
+	auto AppendChunk = [this, bOverwrite, &Contents, &Gone, &Written]()
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!OpenLocked())
+		{
+			return false;
+		}
+
+		TArray<FRecordRef> Records;
+		Records.Reserve(Contents.Num() + Gone.Num());
+		int32 NumContents = 0;
+		for (const TPair<FString, FString>& Pair : Contents)
+		{
+			if (!bOverwrite && Entries.Contains(Pair.Key))
+			{
+				continue; // written while we read the file; that copy is newer
+			}
+			Records.Add({ &Pair.Key, &Pair.Value });
+			++NumContents;
+		}
+		for (const FString& PackageName : Gone)
+		{
+			if (Entries.Contains(PackageName))
+			{
+				Records.Add({ &PackageName, nullptr });
+			}
+		}
+
+		const bool bAppended = AppendLocked(Records);
+		Written += bAppended ? NumContents : 0;
+		Contents.Reset();
+		Gone.Reset();
+		return bAppended || Records.IsEmpty();
+	};
+
+	for (const FString& PackageName : Names)
+	{
+		if (CancelToken && CancelToken->IsCanceled())
+		{
+			break;
+		}
+
+		if (!bOverwrite)
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (OpenLocked() && Entries.Contains(PackageName))
+			{
+				continue;
+			}
+		}
+
+		FString Content;
+		if (FAuditFileUtils::LoadAuditFile(FAuditFileUtils::GetAuditOutputPath(PackageName), Content))
+		{
+			Contents.Add(PackageName, MoveTemp(Content));
+		}
+		else
+		{
+			Gone.Add(PackageName);
+		}
+
+		if (Contents.Num() + Gone.Num() >= ImportBatchSize && !AppendChunk())
+		{
+			break;
+		}
+	}
+	AppendChunk();
+
+	Flush();
+
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Imported %d audit file(s) into %s"), Written, *GetPackPath());
+	return Written;
+}
+
+bool FAuditPackStore::Compact()
+{
+	FScopeLock ScopeLock(&Lock);
+	return OpenLocked() && CompactLocked();
+}
+
+void FAuditPackStore::Flush()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (bOpened && UnflushedRecords > 0)
+	{
+		WriteIndexLocked();
+	}
+}
+
+void FAuditPackStore::Close()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (bOpened && UnflushedRecords > 0)
+	{
+		WriteIndexLocked();
+	}
+	UnmapLocked();
+	Entries.Reset();
+	bOpened = false;
+}
+
+FAuditPackStore::FStats FAuditPackStore::GetStats()
+{
+	FScopeLock ScopeLock(&Lock);
+	FStats Stats;
+	if (OpenLocked())
+	{
+		Stats.NumEntries = Entries.Num();
+		Stats.FileSize = FileSize;
+		Stats.DeadBytes = DeadBytes;
+	}
+	return Stats;
+}
+
+bool FAuditPackStore::OpenLocked()
+{
+	if (bOpened)
+	{
+		return true;
+	}
+
+	Entries.Reset();
+	FileSize = 0;
+	DeadBytes = 0;
+	UnflushedRecords = 0;
+
+	const int64 PackSize = IFileManager::Get().FileSize(*GetPackPath());
+	if (PackSize <= 0)
+	{
+		bOpened = true;
+		return true;
+	}
+
+	int64 IndexedBytes = 0;
+	if (!LoadIndexLocked(PackSize, IndexedBytes))
+	{
+		Entries.Reset();
+		DeadBytes = 0;
+		IndexedBytes = 0;
+	}
+
+	FileSize = ScanRecordsLocked(IndexedBytes, PackSize);
+	bOpened = true;
+
+	if (FileSize < PackSize)
+	{
+		// Torn append (editor killed mid-write). Rewrite without it so later appends stay reachable.
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: %s has %lld unreadable trailing byte(s), compacting"),
+			*GetPackPath(), PackSize - FileSize);
+		if (!CompactLocked())
+		{
+			bOpened = false;
+			return false;
+		}
+	}
+	else if (IndexedBytes < PackSize)
+	{
+		UnflushedRecords = 1;
+	}
+
+	return true;
+}
+
+bool FAuditPackStore::LoadIndexLocked(int64 PackSize, int64& OutIndexedBytes)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetIndexPath()));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int64 PackBytes = 0;
+	uint32 Count = 0;
+	*Reader << Magic << Version << PackBytes << Count;
+	if (Reader->IsError() || Magic != IndexMagic || Version != IndexVersion || PackBytes > PackSize)
+	{
+		return false;
+	}
+
+	Entries.Reserve(Count);
+	TArray<ANSICHAR> KeyBytes;
+	int64 LiveBytes = 0;
+	for (uint32 i = 0; i < Count; ++i)
+	{
+		uint32 KeySize = 0;
+		*Reader << KeySize;
+		if (Reader->IsError() || KeySize == 0 || KeySize > static_cast<uint32>(Reader->TotalSize()))
+		{
+			return false;
+		}
+		KeyBytes.SetNumUninitialized(KeySize);
+		Reader->Serialize(KeyBytes.GetData(), KeySize);
+
+		FEntry Entry;
+		*Reader << Entry.DataOffset << Entry.DataSize;
+		if (Reader->IsError() || Entry.DataOffset + Entry.DataSize > PackBytes)
+		{
+			return false;
+		}
+		Entry.RecordSize = RecordHeaderSize + KeySize + Entry.DataSize;
+		LiveBytes += Entry.RecordSize;
+		Entries.Add(Utf8ToString(KeyBytes.GetData(), KeySize), Entry);
+	}
+
+	DeadBytes = PackBytes - LiveBytes;
+	OutIndexedBytes = PackBytes;
+	return true;
+}
+
+int64 FAuditPackStore::ScanRecordsLocked(int64 From, int64 PackSize)
+{
+	if (From >= PackSize)
+	{
+		return From;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetPackPath(), FILEREAD_AllowWrite));
+	if (!Reader)
+	{
+		return From;
+	}
+
+	TArray<ANSICHAR> KeyBytes;
+	int64 Offset = From;
+	while (Offset + RecordHeaderSize <= PackSize)
+	{
+		Reader->Seek(Offset);
+
+		uint32 Magic = 0;
+		uint32 KeySize = 0;
+		uint32 DataSize = 0;
+		*Reader << Magic << KeySize << DataSize;
+		if (Reader->IsError() || Magic != RecordMagic || KeySize == 0)
+		{
+			break;
+		}
+
+		const bool bRemoved = DataSize == RemovedMarker;
+		const int64 RecordSize = RecordHeaderSize + KeySize + (bRemoved ? 0 : DataSize);
+		if (Offset + RecordSize > PackSize)
+		{
+			break;
+		}
+
+		KeyBytes.SetNumUninitialized(KeySize);
+		Reader->Serialize(KeyBytes.GetData(), KeySize);
+		if (Reader->IsError())
+		{
+			break;
+		}
+
+		const FString PackageName = Utf8ToString(KeyBytes.GetData(), KeySize);
+		if (const FEntry* Existing = Entries.Find(PackageName))
+		{
+			DeadBytes += Existing->RecordSize;
+		}
+
+		if (bRemoved)
+		{
+			Entries.Remove(PackageName);
+			DeadBytes += RecordSize;
+		}
+		else
+		{
+			FEntry& Entry = Entries.Add(PackageName);
+			Entry.DataOffset = Offset + RecordHeaderSize + KeySize;
+			Entry.DataSize = DataSize;
+			Entry.RecordSize = static_cast<uint32>(RecordSize);
+		}
+
+		Offset += RecordSize;
+	}
+
+	return Offset;
+}
+
+bool FAuditPackStore::AppendLocked(TConstArrayView<FRecordRef> Records)
+{
+	if (Records.IsEmpty())
+	{
+		return false;
+	}
+
+	// Windows will not open a mapped file for writing; the next read maps it again
+	UnmapLocked();
+
+	TArray<uint32> KeySizes;
+	TArray<uint32> DataSizes;
+	KeySizes.Reserve(Records.Num());
+	DataSizes.Reserve(Records.Num());
+
+	bool bWritten = false;
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*GetPackPath(), FILEWRITE_Append | FILEWRITE_AllowRead));
+		if (Writer)
+		{
+			for (const FRecordRef& Record : Records)
+			{
+				const FString& PackageName = *Record.PackageName;
+				const FTCHARToUTF8 Key(*PackageName, PackageName.Len());
+				const FTCHARToUTF8 Data(Record.Content ? **Record.Content : TEXT(""), Record.Content ? Record.Content->Len() : 0);
+
+				uint32 Magic = RecordMagic;
+				uint32 KeySize = Key.Length();
+				uint32 DataSize = Record.Content ? Data.Length() : RemovedMarker;
+				*Writer << Magic << KeySize << DataSize;
+				SerializeBytes(*Writer, Key.Get(), KeySize);
+				if (Record.Content)
+				{
+					SerializeBytes(*Writer, Data.Get(), DataSize);
+				}
+
+				KeySizes.Add(KeySize);
+				DataSizes.Add(DataSize);
+			}
+			bWritten = Writer->Close();
+		}
+	}
+
+	if (!bWritten)
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to append %d record(s) to %s"), Records.Num(), *GetPackPath());
+		bOpened = false; // rescan on next use in case partial records landed
+		return false;
+	}
+
+	for (int32 i = 0; i < Records.Num(); ++i)
+	{
+		const FString& PackageName = *Records[i].PackageName;
+		const bool bRemoved = Records[i].Content == nullptr;
+		const int64 RecordOffset = FileSize;
+		const uint32 RecordSize = RecordHeaderSize + KeySizes[i] + (bRemoved ? 0 : DataSizes[i]);
+		FileSize += RecordSize;
+
+		if (const FEntry* Existing = Entries.Find(PackageName))
+		{
+			DeadBytes += Existing->RecordSize;
+		}
+
+		if (!bRemoved)
+		{
+			FEntry& Entry = Entries.Add(PackageName);
+			Entry.DataOffset = RecordOffset + RecordHeaderSize + KeySizes[i];
+			Entry.DataSize = DataSizes[i];
+			Entry.RecordSize = RecordSize;
+		}
+		else
+		{
+			Entries.Remove(PackageName);
+			DeadBytes += RecordSize;
+		}
+	}
+
+	UnflushedRecords += Records.Num();
+	if (UnflushedRecords >= IndexFlushInterval)
+	{
+		WriteIndexLocked();
+	}
+
+	CompactIfWastefulLocked();
+	return true;
+}
+
+bool FAuditPackStore::MapLocked()
+{
+	if (MappedRegion)
+	{
+		return true;
+	}
+	if (FileSize == 0)
+	{
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult Result = PlatformFile.OpenMappedEx(*GetPackPath());
+	if (Result.HasError())
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to map %s"), *GetPackPath());
+		return false;
+	}
+
+	MappedFile = Result.StealValue();
+	MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+	if (!MappedRegion)
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to map %lld byte(s) of %s"), FileSize, *GetPackPath());
+		MappedFile.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FAuditPackStore::UnmapLocked()
+{
+	// Region first: it borrows the handle
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FAuditPackStore::WriteIndexLocked()
+{
+	TArray<FString> Keys;
+	Entries.GetKeys(Keys);
+	SortKeys(Keys);
+
+	const FString IndexPath = GetIndexPath();
+	const FString TempPath = IndexPath + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!Writer)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write %s"), *TempPath);
+			return false;
+		}
+
+		uint32 Magic = IndexMagic;
+		uint32 Version = IndexVersion;
+		int64 PackBytes = FileSize;
+		uint32 Count = Keys.Num();
+		*Writer << Magic << Version << PackBytes << Count;
+
+		for (const FString& Key : Keys)
+		{
+			FEntry Entry = Entries.FindChecked(Key);
+			const FTCHARToUTF8 KeyUtf8(*Key, Key.Len());
+			uint32 KeySize = KeyUtf8.Length();
+			*Writer << KeySize;
+			SerializeBytes(*Writer, KeyUtf8.Get(), KeySize);
+			*Writer << Entry.DataOffset << Entry.DataSize;
+		}
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write %s"), *TempPath);
+			Writer.Reset();
+			IFileManager::Get().Delete(*TempPath);
+			return false;
+		}
+	}
+
+	if (!IFileManager::Get().Move(*IndexPath, *TempPath, /*Replace=*/ true))
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to replace %s"), *IndexPath);
+		IFileManager::Get().Delete(*TempPath);
+		return false;
+	}
+
+	UnflushedRecords = 0;
+	return true;
+}
+
+bool FAuditPackStore::CompactLocked()
+{
+	TArray<FString> Keys;
+	Entries.GetKeys(Keys);
+	SortKeys(Keys);
+
+	if (Keys.Num() > 0 && !MapLocked())
+	{
+		return false;
+	}
+
+	const FString PackPath = GetPackPath();
+	const FString TempPath = PackPath + TEXT(".tmp");
+
+	TMap<FString, FEntry> NewEntries;
+	NewEntries.Reserve(Keys.Num());
+	int64 NewSize = 0;
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!Writer)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write %s"), *TempPath);
+			return false;
+		}
+
+		for (const FString& Key : Keys)
+		{
+			const FEntry& Entry = Entries.FindChecked(Key);
+			const FTCHARToUTF8 KeyUtf8(*Key, Key.Len());
+
+			uint32 Magic = RecordMagic;
+			uint32 KeySize = KeyUtf8.Length();
+			uint32 DataSize = Entry.DataSize;
+			*Writer << Magic << KeySize << DataSize;
+			SerializeBytes(*Writer, KeyUtf8.Get(), KeySize);
+			SerializeBytes(*Writer, MappedRegion->GetMappedPtr() + Entry.DataOffset, DataSize);
+
+			FEntry& NewEntry = NewEntries.Add(Key);
+			NewEntry.DataOffset = NewSize + RecordHeaderSize + KeySize;
+			NewEntry.DataSize = DataSize;
+			NewEntry.RecordSize = RecordHeaderSize + KeySize + DataSize;
+			NewSize += NewEntry.RecordSize;
+		}
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write %s"), *TempPath);
+			Writer.Reset();
+			IFileManager::Get().Delete(*TempPath);
+			return false;
+		}
+	}
+
+	// Drop the old index first: if we die between the two renames, the next open
+	// rescans the new pack instead of trusting offsets into the old one
+	UnmapLocked();
+	IFileManager::Get().Delete(*GetIndexPath());
+	if (!IFileManager::Get().Move(*PackPath, *TempPath, /*Replace=*/ true))
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to replace %s (mapped by another process?)"), *PackPath);
+		IFileManager::Get().Delete(*TempPath);
+		UnflushedRecords = FMath::Max(UnflushedRecords, 1);
+		return false;
+	}
+
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Compacted %s, %lld -> %lld bytes (%d audits)"),
+		*PackPath, FileSize, NewSize, NewEntries.Num());
+
+	Entries = MoveTemp(NewEntries);
+	FileSize = NewSize;
+	DeadBytes = 0;
+	WriteIndexLocked();
+	return true;
+}
+
+void FAuditPackStore::CompactIfWastefulLocked()
+{
+	if (DeadBytes > CompactMinDeadBytes && DeadBytes > FileSize - DeadBytes)
+	{
+		CompactLocked();
+	}
+}
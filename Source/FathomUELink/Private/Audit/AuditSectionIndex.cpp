@@ -0,0 +1,265 @@
+#include "Audit/AuditSectionIndex.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/Archive.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	const FString TablePrefix = TEXT("<!-- fathom-sections ");
+	const FString OffsetPrefix = TEXT("<!-- fathom-sections-at ");
+	const FString CommentSuffix = TEXT(" -->");
+
+	/** The offset line is short; this much of the tail always holds it. */
+	constexpr int64 TailBytes = 64;
+
+	int64 Utf8Length(const TCHAR* Chars, int32 NumChars)
+	{
+		return FPlatformString::ConvertedLength<UTF8CHAR>(Chars, NumChars);
+	}
+
+	FString Utf8BytesToString(const TArray<uint8>& Bytes)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	bool ReadFileRange(FArchive& Reader, int64 Offset, int64 Length, TArray<uint8>& OutBytes)
+	{
+		if (Offset < 0 || Length < 0 || Offset + Length > Reader.TotalSize() || Length > MAX_int32)
+		{
+			return false;
+		}
+		OutBytes.SetNumUninitialized(static_cast<int32>(Length));
+		Reader.Seek(Offset);
+		Reader.Serialize(OutBytes.GetData(), Length);
+		return !Reader.IsError();
+	}
+}
+
+TArray<FAuditSectionIndex::FSection> FAuditSectionIndex::Build(const FString& Markdown)
+{
+	TArray<FSection> Sections;
+	TArray<int32> OpenSections;     // enclosing sections, outermost first
+	bool bInCodeFence = false;
+	int64 ByteOffset = 0;
+
+	const int32 Len = Markdown.Len();
+	int32 LineStart = 0;
+	while (LineStart < Len)
+	{
+		int32 LineEnd = Markdown.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, LineStart);
+		if (LineEnd == INDEX_NONE)
+		{
+			LineEnd = Len;
+		}
+		const FStringView Line(*Markdown + LineStart, LineEnd - LineStart);
+
+		if (Line.StartsWith(TEXT("```")))
+		{
+			bInCodeFence = !bInCodeFence;
+		}
+		else if (!bInCodeFence && Line.StartsWith(TEXT("##")))
+		{
+			int32 Level = 0;
+			while (Level < Line.Len() && Line[Level] == TEXT('#'))
+			{
+				++Level;
+			}
+
+			if (Level <= 6 && Level < Line.Len() && Line[Level] == TEXT(' '))
+			{
+				while (OpenSections.Num() > 0 && Sections[OpenSections.Last()].Level >= Level)
+				{
+					FSection& Closed = Sections[OpenSections.Pop()];
+					Closed.Length = ByteOffset - Closed.Offset;
+				}
+
+				FSection Section;
+				Section.Name = FString(Line.Mid(Level + 1)).TrimEnd();
+				Section.Path = OpenSections.Num() > 0
+					? Sections[OpenSections.Last()].Path + TEXT("/") + Section.Name
+					: Section.Name;
+				Section.Level = Level;
+				Section.Offset = ByteOffset;
+				OpenSections.Add(Sections.Add(MoveTemp(Section)));
+			}
+		}
+
+		ByteOffset += Utf8Length(Line.GetData(), Line.Len()) + (LineEnd < Len ? 1 : 0);
+		LineStart = LineEnd + 1;
+	}
+
+	for (const int32 Index : OpenSections)
+	{
+		Sections[Index].Length = ByteOffset - Sections[Index].Offset;
+	}
+	return Sections;
+}
+
+void FAuditSectionIndex::Attach(FString& InOutMarkdown)
+{
+	Strip(InOutMarkdown);
+	if (InOutMarkdown.Len() < MinIndexedChars)
+	{
+		return;
+	}
+
+	const TArray<FSection> Sections = Build(InOutMarkdown);
+	if (Sections.IsEmpty())
+	{
+		return;
+	}
+
+	FString Json;
+	Json.Reserve(Sections.Num() * 96);
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+	Writer->WriteArrayStart();
+	for (const FSection& Section : Sections)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Section.Name);
+		Writer->WriteValue(TEXT("path"), Section.Path);
+		Writer->WriteValue(TEXT("level"), Section.Level);
+		Writer->WriteValue(TEXT("offset"), Section.Offset);
+		Writer->WriteValue(TEXT("length"), Section.Length);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->Close();
+
+	// A heading containing "-->" must not end the comment early
+	Json.ReplaceInline(TEXT("-->"), TEXT("--\\u003e"), ESearchCase::CaseSensitive);
+
+	if (!InOutMarkdown.EndsWith(TEXT("\n")))
+	{
+		InOutMarkdown += TEXT("\n");
+	}
+	const int64 TableOffset = Utf8Length(*InOutMarkdown, InOutMarkdown.Len());
+	InOutMarkdown += TablePrefix + Json + CommentSuffix + TEXT("\n");
+	InOutMarkdown += FString::Printf(TEXT("%s%lld%s\n"), *OffsetPrefix, TableOffset, *CommentSuffix);
+}
+
+void FAuditSectionIndex::Strip(FString& InOutMarkdown)
+{
+	const int32 TablePos = InOutMarkdown.Find(TEXT("\n") + TablePrefix, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if (TablePos != INDEX_NONE && InOutMarkdown.Find(OffsetPrefix, ESearchCase::CaseSensitive, ESearchDir::FromStart, TablePos) != INDEX_NONE)
+	{
+		InOutMarkdown.LeftInline(TablePos + 1);
+	}
+}
+
+bool FAuditSectionIndex::Parse(const FString& Markdown, TArray<FSection>& OutSections)
+{
+	const int32 TablePos = Markdown.Find(TablePrefix, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if (TablePos == INDEX_NONE)
+	{
+		return false;
+	}
+	const int32 JsonStart = TablePos + TablePrefix.Len();
+	const int32 JsonEnd = Markdown.Find(CommentSuffix, ESearchCase::CaseSensitive, ESearchDir::FromStart, JsonStart);
+	if (JsonEnd == INDEX_NONE)
+	{
+		return false;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Values;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Markdown.Mid(JsonStart, JsonEnd - JsonStart)), Values))
+	{
+		return false;
+	}
+
+	OutSections.Reset(Values.Num());
+	for (const TSharedPtr<FJsonValue>& Value : Values)
+	{
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		if (!Value.IsValid() || !Value->TryGetObject(Object))
+		{
+			continue;
+		}
+
+		FSection& Section = OutSections.AddDefaulted_GetRef();
+		(*Object)->TryGetStringField(TEXT("name"), Section.Name);
+		(*Object)->TryGetStringField(TEXT("path"), Section.Path);
+		(*Object)->TryGetNumberField(TEXT("level"), Section.Level);
+		(*Object)->TryGetNumberField(TEXT("offset"), Section.Offset);
+		(*Object)->TryGetNumberField(TEXT("length"), Section.Length);
+	}
+	return true;
+}
+
+bool FAuditSectionIndex::ReadFromFile(const FString& FilePath, TArray<FSection>& OutSections)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	const int64 FileSize = Reader->TotalSize();
+	const int64 TailSize = FMath::Min(FileSize, TailBytes);
+	TArray<uint8> Bytes;
+	if (!ReadFileRange(*Reader, FileSize - TailSize, TailSize, Bytes))
+	{
+		return false;
+	}
+
+	const FString Tail = Utf8BytesToString(Bytes);
+	const int32 OffsetPos = Tail.Find(OffsetPrefix, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if (OffsetPos == INDEX_NONE)
+	{
+		return false;
+	}
+
+	int64 TableOffset = 0;
+	LexFromString(TableOffset, *Tail.Mid(OffsetPos + OffsetPrefix.Len()));
+	if (TableOffset <= 0 || !ReadFileRange(*Reader, TableOffset, FileSize - TableOffset, Bytes))
+	{
+		return false;
+	}
+	return Parse(Utf8BytesToString(Bytes), OutSections);
+}
+
+bool FAuditSectionIndex::ReadSectionFromFile(const FString& FilePath, const FSection& Section, FString& OutText)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	TArray<uint8> Bytes;
+	if (!Reader || !ReadFileRange(*Reader, Section.Offset, Section.Length, Bytes))
+	{
+		return false;
+	}
+	OutText = Utf8BytesToString(Bytes);
+	return true;
+}
+
+FString FAuditSectionIndex::ExtractSection(const FString& Markdown, const FSection& Section)
+{
+	const FTCHARToUTF8 Utf8(*Markdown, Markdown.Len());
+	if (Section.Offset < 0 || Section.Length < 0 || Section.Offset + Section.Length > Utf8.Length())
+	{
+		return FString();
+	}
+	const FUTF8ToTCHAR Converter(Utf8.Get() + Section.Offset, static_cast<int32>(Section.Length));
+	return FString(Converter.Length(), Converter.Get());
+}
+
+const FAuditSectionIndex::FSection* FAuditSectionIndex::Find(const TArray<FSection>& Sections, const FString& NameOrPath)
+{
+	if (const FSection* ByPath = Sections.FindByPredicate([&NameOrPath](const FSection& Section)
+		{
+			return Section.Path.Equals(NameOrPath, ESearchCase::IgnoreCase);
+		}))
+	{
+		return ByPath;
+	}
+	return Sections.FindByPredicate([&NameOrPath](const FSection& Section)
+	{
+		return Section.Name.Equals(NameOrPath, ESearchCase::IgnoreCase);
+	});
+}
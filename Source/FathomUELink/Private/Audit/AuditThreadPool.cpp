@@ -0,0 +1,52 @@
+#include "Audit/AuditThreadPool.h"
+
+#include "FathomAuditSettings.h"
+#include "FathomUELinkModule.h"
+
+FAuditThreadPool& FAuditThreadPool::Get()
+{
+	static FAuditThreadPool Instance;
+	return Instance;
+}
+
+FAuditThreadPool::FStats FAuditThreadPool::GetStats() const
+{
+	FStats Stats;
+	Stats.NumThreads = NumThreads;
+	Stats.Queued = QueuedCount.GetValue();
+	Stats.Running = RunningCount.GetValue();
+	Stats.Completed = CompletedCount.GetValue();
+	return Stats;
+}
+
+void FAuditThreadPool::Shutdown()
+{
+	FQueuedThreadPool* OldPool;
+	{
+		FScopeLock Lock(&PoolLock);
+		bShutDown.store(true, std::memory_order_release);
+		OldPool = Pool;
+		Pool = nullptr;
+		NumThreads = 0;
+	}
+
+	// Outside the lock: a task still running may Launch (e.g. to schedule a write drain)
+	if (OldPool)
+	{
+		OldPool->Destroy();
+		delete OldPool;
+	}
+}
+
+FQueuedThreadPool* FAuditThreadPool::GetPoolLocked()
+{
+	if (!Pool && !bShutDown.load(std::memory_order_acquire))
+	{
+		NumThreads = FMath::Clamp(GetDefault<UFathomAuditSettings>()->AuditThreadCount, 1, 16);
+		Pool = FQueuedThreadPool::Allocate();
+		verify(Pool->Create(NumThreads, ThreadStackSize, TPri_Lowest, TEXT("FathomAuditPool")));
+
+		UE_LOG(LogFathomUELink, Log, TEXT("Fathom: Audit thread pool started with %d thread(s)"), NumThreads);
+	}
+	return Pool;
+}
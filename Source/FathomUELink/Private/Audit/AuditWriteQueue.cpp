@@ -0,0 +1,339 @@
+#include "Audit/AuditWriteQueue.h"
+
+#include "Audit/AuditFileUtils.h"
+#include "Audit/AuditIndex.h"
+#include "Audit/AuditMigrations.h"
+#include "Audit/AuditPackStore.h"
+#include "Audit/AuditThreadPool.h"
+#include "FathomUELinkModule.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+FAuditWriteQueue& FAuditWriteQueue::Get()
+{
+	static FAuditWriteQueue Instance;
+	return Instance;
+}
+
+bool FAuditWriteQueue::Enqueue(const FString& OutputPath, const FString& PackageName, const FString& Content, const FString& OutputHash,
+	bool bMigration)
+{
+	bool bScheduleDrain;
+	{
+		FScopeLock ScopeLock(&Lock);
+		FailedPaths.Remove(OutputPath);
+
+		// A pending or in-flight write may hold other content, so the index does not
+		// describe what will end up on disk
+		if (!Pending.Contains(OutputPath) && !InFlight.Contains(OutputPath)
+			&& !PackageName.IsEmpty() && FAuditIndex::IsEnabled()
+			&& FAuditIndex::Get().GetOutputHash(PackageName) == OutputHash
+			&& FAuditFileUtils::AuditFileExists(OutputPath))
+		{
+			return false;
+		}
+
+		bScheduleDrain = AddLocked(OutputPath, PackageName, Content, OutputHash, bMigration);
+	}
+
+	if (bScheduleDrain)
+	{
+		ScheduleDrain();
+	}
+	return true;
+}
+
+bool FAuditWriteQueue::EnqueueIfAbsent(const FString& OutputPath, const FString& PackageName, const FString& Content, const FString& OutputHash)
+{
+	bool bScheduleDrain;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// In-flight writes hold the lock's view until their rename is done, so a file the
+		// drainer is about to create still counts as present
+		if (Pending.Contains(OutputPath) || InFlight.Contains(OutputPath) || FAuditFileUtils::AuditFileExists(OutputPath))
+		{
+			return false;
+		}
+
+		FailedPaths.Remove(OutputPath);
+		bScheduleDrain = AddLocked(OutputPath, PackageName, Content, OutputHash, /*bMigration=*/ false);
+	}
+
+	if (bScheduleDrain)
+	{
+		ScheduleDrain();
+	}
+	return true;
+}
+
+bool FAuditWriteQueue::AddLocked(const FString& OutputPath, const FString& PackageName, const FString& Content, const FString& OutputHash,
+	bool bMigration)
+{
+	FPendingWrite& Write = Pending.FindOrAdd(OutputPath);
+	Write.OutputPath = OutputPath;
+	Write.PackageName = PackageName;
+	Write.Content = Content;
+	Write.OutputHash = OutputHash;
+	Write.bMigration = bMigration;
+
+	// After shutdown a drain queued before it may have been abandoned with the pool,
+	// so bDrainScheduled cannot be trusted: every enqueue drains for itself
+	if (bDrainScheduled && !FAuditThreadPool::Get().IsShutDown())
+	{
+		return false;
+	}
+	bDrainScheduled = true;
+	return true;
+}
+
+void FAuditWriteQueue::ScheduleDrain()
+{
+	// Runs DrainAll on the calling thread once the pool is shut down
+	FAuditThreadPool::Get().Launch([this]()
+	{
+		DrainAll();
+	});
+}
+
+void FAuditWriteQueue::Cancel(const FString& OutputPath)
+{
+	FScopeLock ScopeLock(&Lock);
+	Pending.Remove(OutputPath);
+}
+
+void FAuditWriteQueue::Flush()
+{
+	while (true)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (Pending.IsEmpty() && !bDraining)
+			{
+				return;
+			}
+		}
+
+		if (!DrainOnce())
+		{
+			FPlatformProcess::SleepNoStats(0.001f);
+		}
+	}
+}
+
+bool FAuditWriteQueue::WaitForWrite(const FString& OutputPath)
+{
+	while (true)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (!Pending.Contains(OutputPath) && !InFlight.Contains(OutputPath))
+			{
+				return !FailedPaths.Contains(OutputPath);
+			}
+		}
+
+		if (!DrainOnce())
+		{
+			FPlatformProcess::SleepNoStats(0.001f);
+		}
+	}
+}
+
+bool FAuditWriteQueue::IsPending(const FString& OutputPath)
+{
+	FScopeLock ScopeLock(&Lock);
+	return Pending.Contains(OutputPath) || InFlight.Contains(OutputPath);
+}
+
+int32 FAuditWriteQueue::GetNumPending()
+{
+	FScopeLock ScopeLock(&Lock);
+	return Pending.Num() + InFlight.Num();
+}
+
+void FAuditWriteQueue::DrainAll()
+{
+	while (true)
+	{
+		if (!DrainOnce())
+		{
+			// Flush is draining on another thread
+			FPlatformProcess::SleepNoStats(0.001f);
+		}
+
+		// Cleared under the same lock Enqueue checks it with, so no write is left behind
+		FScopeLock ScopeLock(&Lock);
+		if (Pending.IsEmpty())
+		{
+			bDrainScheduled = false;
+			return;
+		}
+	}
+}
+
+bool FAuditWriteQueue::DrainOnce()
+{
+	TArray<FPendingWrite> Batch;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bDraining)
+		{
+			return false;
+		}
+		if (Pending.IsEmpty())
+		{
+			return true;
+		}
+
+		bDraining = true;
+		Batch.Reserve(Pending.Num());
+		for (TPair<FString, FPendingWrite>& Pair : Pending)
+		{
+			InFlight.Add(Pair.Key);
+			Batch.Add(MoveTemp(Pair.Value));
+		}
+		Pending.Reset();
+	}
+
+	TArray<FString> BatchFailedPaths;
+	WriteBatch(Batch, BatchFailedPaths);
+
+	FScopeLock ScopeLock(&Lock);
+	for (const FPendingWrite& Write : Batch)
+	{
+		FailedPaths.Remove(Write.OutputPath);
+	}
+	FailedPaths.Append(BatchFailedPaths);
+	InFlight.Reset();
+	bDraining = false;
+	return true;
+}
+
+void FAuditWriteQueue::WriteBatch(TArray<FPendingWrite>& Batch, TArray<FString>& OutFailedPaths)
+{
+	// Group by directory: each directory is checked once per drain at most
+	Batch.Sort([](const FPendingWrite& A, const FPendingWrite& B)
+	{
+		return A.OutputPath < B.OutputPath;
+	});
+
+	FString CurrentDir;
+	int32 NumWritten = 0;
+	TMap<FString, FString> PackContents;
+	for (FPendingWrite& Write : Batch)
+	{
+		const FString Dir = FPaths::GetPath(Write.OutputPath);
+		if (Dir != CurrentDir)
+		{
+			EnsureDirectory(Dir);
+			CurrentDir = Dir;
+		}
+
+		const FString StoredPath = FAuditFileUtils::GetStoredAuditPath(Write.OutputPath);
+		if (!WriteFile(Write, StoredPath))
+		{
+			FailedCount.Increment();
+			OutFailedPaths.Add(Write.OutputPath);
+			UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Failed to write %s"), *Write.OutputPath);
+			continue;
+		}
+
+		++NumWritten;
+		WrittenCount.Increment();
+		if (Write.bMigration)
+		{
+			FAuditMigrationRegistry::Get().NotifyMigrated();
+		}
+		UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Audit saved to %s"), *StoredPath);
+
+		if (!Write.PackageName.IsEmpty())
+		{
+			if (FAuditIndex::IsEnabled())
+			{
+				FAuditIndex::Get().RecordWrite(Write.PackageName, StoredPath, Write.Content, Write.OutputHash);
+			}
+			if (FAuditPackStore::IsEnabled())
+			{
+				// The batch is done with the content once the file and index have it
+				PackContents.Add(Write.PackageName, MoveTemp(Write.Content));
+			}
+		}
+	}
+
+	// One append of the pack for the whole drain
+	if (!PackContents.IsEmpty())
+	{
+		FAuditPackStore::Get().WriteMany(PackContents);
+	}
+
+	UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Write-behind flushed %d/%d audit(s)"), NumWritten, Batch.Num());
+}
+
+bool FAuditWriteQueue::WriteFile(const FPendingWrite& Write, const FString& StoredPath)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	// Unique per write: the offloaded child and commandlets write into the same tree,
+	// and a shared temp name would let one process truncate or rename the other's
+	const FString TempPath = FString::Printf(TEXT("%s.%s.tmp"), *StoredPath, *FGuid::NewGuid().ToString());
+
+	TArray<uint8> Compressed;
+	if (StoredPath != Write.OutputPath && !FAuditFileUtils::CompressAuditContent(Write.Content, Compressed))
+	{
+		return false;
+	}
+
+	TUniquePtr<IFileHandle> Handle(PlatformFile.OpenWrite(*TempPath));
+	if (!Handle)
+	{
+		// The directory was removed behind the cache (e.g. by an orphan sweep)
+		const FString Dir = FPaths::GetPath(Write.OutputPath);
+		KnownDirectories.Remove(Dir);
+		EnsureDirectory(Dir);
+		Handle.Reset(PlatformFile.OpenWrite(*TempPath));
+		if (!Handle)
+		{
+			return false;
+		}
+	}
+
+	bool bWritten;
+	if (!Compressed.IsEmpty())
+	{
+		bWritten = Handle->Write(Compressed.GetData(), Compressed.Num());
+	}
+	else
+	{
+		const FTCHARToUTF8 Utf8(*Write.Content, Write.Content.Len());
+		bWritten = Handle->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+	Handle.Reset();
+
+	// Rename replaces the target atomically on POSIX. Windows refuses to rename over an
+	// existing file, so delete it first there; the old content is never half-overwritten.
+	if (!bWritten
+		|| (!PlatformFile.MoveFile(*StoredPath, *TempPath)
+			&& !(PlatformFile.DeleteFile(*StoredPath) && PlatformFile.MoveFile(*StoredPath, *TempPath))))
+	{
+		PlatformFile.DeleteFile(*TempPath);
+		return false;
+	}
+
+	// Written in the other storage mode before the setting changed
+	const FString OtherPath = StoredPath == Write.OutputPath
+		? Write.OutputPath + FAuditFileUtils::CompressedSuffix : Write.OutputPath;
+	PlatformFile.DeleteFile(*OtherPath);
+	return true;
+}
+
+void FAuditWriteQueue::EnsureDirectory(const FString& Dir)
+{
+	if (KnownDirectories.Contains(Dir))
+	{
+		return;
+	}
+
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*Dir);
+	KnownDirectories.Add(Dir);
+}
@@ -529,6 +529,7 @@ FString FBehaviorTreeAuditor::SerializeToMarkdown(const FBehaviorTreeAuditData&
 	{
 		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
 		Result += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(Data.SourceFilePath));
+		Result += FString::Printf(TEXT("AuditSchema: BehaviorTree/%d\n"), FBehaviorTreeAuditor::SchemaVersion);
 	}
 
 	if (!Data.BlackboardAssetPath.IsEmpty())
@@ -0,0 +1,133 @@
+#include "Audit/BlueprintGatherTask.h"
+
+#include "Audit/BlueprintGraphAuditor.h"
+#include "FathomUELinkModule.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "UObject/UObjectGlobals.h"
+
+FBlueprintGatherTask::FBlueprintGatherTask(UBlueprint* InBlueprint)
+	: Blueprint(InBlueprint)
+	, PackageName(InBlueprint->GetOutermost()->GetName())
+{
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FBlueprintGatherTask::OnObjectModified);
+	CompiledHandle = Blueprint->OnCompiled().AddRaw(this, &FBlueprintGatherTask::OnBlueprintCompiled);
+}
+
+FBlueprintGatherTask::~FBlueprintGatherTask()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	if (Blueprint)
+	{
+		Blueprint->OnCompiled().Remove(CompiledHandle);
+	}
+}
+
+bool FBlueprintGatherTask::Step(double BudgetSeconds)
+{
+	if (bModifiedSinceStep)
+	{
+		bModifiedSinceStep = false;
+		if (Stage != EStage::Done)
+		{
+			Restart();
+		}
+	}
+
+	if (Stage != EStage::Done && RestartCount > MaxRestarts)
+	{
+		// Keeps changing under us: take one consistent snapshot and accept the hitch
+		UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: %s modified %d times during gather, gathering in one pass"),
+			*PackageName, RestartCount);
+		Data = FBlueprintGraphAuditor::GatherBlueprintData(Blueprint);
+		Stage = EStage::Done;
+	}
+
+	const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
+	do
+	{
+		switch (Stage)
+		{
+		case EStage::Metadata:
+			Data = FBlueprintGraphAuditor::GatherBlueprintMetadata(Blueprint);
+			Data.EventGraphs.Reserve(Blueprint->UbergraphPages.Num());
+			Data.FunctionGraphs.Reserve(Blueprint->FunctionGraphs.Num());
+			Data.MacroGraphs.Reserve(Blueprint->MacroGraphs.Num());
+			Stage = EStage::EventGraphs;
+			GraphIndex = 0;
+			break;
+
+		case EStage::EventGraphs:
+		case EStage::FunctionGraphs:
+		case EStage::MacroGraphs:
+		{
+			const TArray<TObjectPtr<UEdGraph>>& Graphs =
+				Stage == EStage::EventGraphs ? Blueprint->UbergraphPages
+				: Stage == EStage::FunctionGraphs ? Blueprint->FunctionGraphs
+				: Blueprint->MacroGraphs;
+			TArray<FGraphAuditData>& Out =
+				Stage == EStage::EventGraphs ? Data.EventGraphs
+				: Stage == EStage::FunctionGraphs ? Data.FunctionGraphs
+				: Data.MacroGraphs;
+
+			if (GraphIndex >= Graphs.Num())
+			{
+				Stage = static_cast<EStage>(static_cast<uint8>(Stage) + 1);
+				GraphIndex = 0;
+				break;
+			}
+
+			if (const UEdGraph* Graph = Graphs[GraphIndex++])
+			{
+				Out.Add(FBlueprintGraphAuditor::GatherGraphData(Graph));
+			}
+			break;
+		}
+
+		case EStage::Done:
+			break;
+		}
+	}
+	while (Stage != EStage::Done && FPlatformTime::Seconds() < Deadline);
+
+	return Stage == EStage::Done;
+}
+
+FBlueprintAuditData FBlueprintGatherTask::TakeData()
+{
+	check(Stage == EStage::Done);
+	return MoveTemp(Data);
+}
+
+void FBlueprintGatherTask::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(Blueprint);
+}
+
+FString FBlueprintGatherTask::GetReferencerName() const
+{
+	return TEXT("FBlueprintGatherTask");
+}
+
+void FBlueprintGatherTask::Restart()
+{
+	++RestartCount;
+	UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: %s modified mid-gather, restarting (%d)"), *PackageName, RestartCount);
+
+	Data = FBlueprintAuditData();
+	Stage = EStage::Metadata;
+	GraphIndex = 0;
+}
+
+void FBlueprintGatherTask::OnObjectModified(UObject* Object)
+{
+	if (Object && Blueprint && Object->GetOutermost() == Blueprint->GetOutermost())
+	{
+		bModifiedSinceStep = true;
+	}
+}
+
+void FBlueprintGatherTask::OnBlueprintCompiled(UBlueprint* CompiledBlueprint)
+{
+	bModifiedSinceStep = true;
+}
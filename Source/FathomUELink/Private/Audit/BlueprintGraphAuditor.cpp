@@ -124,6 +124,37 @@ namespace
 // ============================================================================
 
 FBlueprintAuditData FBlueprintGraphAuditor::GatherBlueprintData(const UBlueprint* BP)
+{
+	FBlueprintAuditData Data = GatherBlueprintMetadata(BP);
+
+	// --- Event Graphs (UbergraphPages) ---
+	Data.EventGraphs.Reserve(BP->UbergraphPages.Num());
+	for (UEdGraph* Graph : BP->UbergraphPages)
+	{
+		if (!Graph) continue;
+		Data.EventGraphs.Add(GatherGraphData(Graph));
+	}
+
+	// --- Function Graphs ---
+	Data.FunctionGraphs.Reserve(BP->FunctionGraphs.Num());
+	for (UEdGraph* Graph : BP->FunctionGraphs)
+	{
+		if (!Graph) continue;
+		Data.FunctionGraphs.Add(GatherGraphData(Graph));
+	}
+
+	// --- Macro Graphs (full topology, same as event/function graphs) ---
+	Data.MacroGraphs.Reserve(BP->MacroGraphs.Num());
+	for (UEdGraph* Graph : BP->MacroGraphs)
+	{
+		if (!Graph) continue;
+		Data.MacroGraphs.Add(GatherGraphData(Graph));
+	}
+
+	return Data;
+}
+
+FBlueprintAuditData FBlueprintGraphAuditor::GatherBlueprintMetadata(const UBlueprint* BP)
 {
 	FBlueprintAuditData Data;
 
@@ -314,30 +345,6 @@ FBlueprintAuditData FBlueprintGraphAuditor::GatherBlueprintData(const UBlueprint
 		}
 	}
 
-	// --- Event Graphs (UbergraphPages) ---
-	Data.EventGraphs.Reserve(BP->UbergraphPages.Num());
-	for (UEdGraph* Graph : BP->UbergraphPages)
-	{
-		if (!Graph) continue;
-		Data.EventGraphs.Add(GatherGraphData(Graph));
-	}
-
-	// --- Function Graphs ---
-	Data.FunctionGraphs.Reserve(BP->FunctionGraphs.Num());
-	for (UEdGraph* Graph : BP->FunctionGraphs)
-	{
-		if (!Graph) continue;
-		Data.FunctionGraphs.Add(GatherGraphData(Graph));
-	}
-
-	// --- Macro Graphs (full topology, same as event/function graphs) ---
-	Data.MacroGraphs.Reserve(BP->MacroGraphs.Num());
-	for (UEdGraph* Graph : BP->MacroGraphs)
-	{
-		if (!Graph) continue;
-		Data.MacroGraphs.Add(GatherGraphData(Graph));
-	}
-
 	return Data;
 }
 
@@ -676,6 +683,7 @@ FString FBlueprintGraphAuditor::SerializeToMarkdown(const FBlueprintAuditData& D
 	{
 		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
 		Result += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(Data.SourceFilePath));
+		Result += FString::Printf(TEXT("AuditSchema: Blueprint/%d\n"), FBlueprintGraphAuditor::SchemaVersion);
 	}
 
 	// --- Variables ---
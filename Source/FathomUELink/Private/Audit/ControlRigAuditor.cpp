@@ -275,6 +275,7 @@ FString FControlRigAuditor::SerializeToMarkdown(const FControlRigAuditData& Data
 	{
 		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
 		Result += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(Data.SourceFilePath));
+		Result += FString::Printf(TEXT("AuditSchema: ControlRig/%d\n"), FControlRigAuditor::SchemaVersion);
 	}
 
 	// --- Variables ---
@@ -82,6 +82,7 @@ FString FDataAssetAuditor::SerializeToMarkdown(const FDataAssetAuditData& Data)
 	{
 		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
 		Result += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(Data.SourceFilePath));
+		Result += FString::Printf(TEXT("AuditSchema: DataAsset/%d\n"), FDataAssetAuditor::SchemaVersion);
 	}
 
 	// Properties
@@ -88,6 +88,7 @@ FString FDataTableAuditor::SerializeToMarkdown(const FDataTableAuditData& Data)
 	{
 		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
 		Result += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(Data.SourceFilePath));
+		Result += FString::Printf(TEXT("AuditSchema: DataTable/%d\n"), FDataTableAuditor::SchemaVersion);
 	}
 
 	// Numbered column legend
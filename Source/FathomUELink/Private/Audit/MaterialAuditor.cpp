@@ -398,6 +398,7 @@ FString FMaterialAuditor::SerializeToMarkdown(const FMaterialAuditData& Data)
 	{
 		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
 		Result += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(Data.SourceFilePath));
+		Result += FString::Printf(TEXT("AuditSchema: Material/%d\n"), FMaterialAuditor::SchemaVersion);
 	}
 
 	// Properties (all editable Details panel properties)
@@ -82,6 +82,7 @@ FString FUserDefinedStructAuditor::SerializeToMarkdown(const FUserDefinedStructA
 	{
 		Result += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(Data.SourceFilePath));
 		Result += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(Data.SourceFilePath));
+		Result += FString::Printf(TEXT("AuditSchema: UserDefinedStruct/%d\n"), FUserDefinedStructAuditor::SchemaVersion);
 	}
 
 	// Fields
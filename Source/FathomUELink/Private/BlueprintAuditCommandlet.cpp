@@ -1,185 +1,329 @@
 #include "BlueprintAuditCommandlet.h"
 
-#include "BlueprintAuditor.h"
 #include "FathomUELinkModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
-#include "FathomControlRig.h"
-#include "Engine/Blueprint.h"
-#include "Engine/DataAsset.h"
-#include "Engine/DataTable.h"
-#include "StructUtils/UserDefinedStruct.h"
+#include "Audit/AssetStubAuditor.h"
+#include "Audit/AuditCache.h"
 #include "Audit/AuditFileUtils.h"
-#include "Audit/MaterialAuditor.h"
-#include "Materials/Material.h"
-#include "Materials/MaterialInstanceConstant.h"
-#include "BehaviorTree/BehaviorTree.h"
+#include "Audit/AuditAssetUtils.h"
 #include "Audit/AuditExtensionRegistry.h"
+#include "Audit/AuditJournal.h"
+#include "Audit/AuditWriteQueue.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
 #include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
 
-UBlueprintAuditCommandlet::UBlueprintAuditCommandlet()
+namespace
 {
-	IsClient = false;
-	IsEditor = true;
-	IsServer = false;
-	LogToConsole = true;
-}
+	constexpr int32 GCInterval = 50;
 
-int32 UBlueprintAuditCommandlet::Main(const FString& Params)
-{
-	// Parse parameters
-	FString AssetPath;
-	FParse::Value(*Params, TEXT("-AssetPath="), AssetPath);
+	/** Crash restarts a supervised run allows before giving up (-MaxRestarts overrides). */
+	constexpr int32 DefaultMaxRestarts = 10;
 
-	FString OutputPath;
-	FParse::Value(*Params, TEXT("-Output="), OutputPath);
+	/** Most assets loaded between collections when clustering, however large a cluster gets. */
+	constexpr int32 ClusterGCHardCap = 500;
 
-	// Initialize asset registry
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-	AssetRegistry.SearchAllAssets(true);
+	/**
+	 * Load, gather, serialize and write one entry inline. Returns true once the audit
+	 * file is on disk: the write-behind queue is waited on, so a journal "done" line
+	 * never covers an audit that a crash could still lose, and failed writes count as
+	 * failures.
+	 */
+	bool AuditEntrySynchronously(const FStaleCheckEntry& Entry)
+	{
+		TOptional<FAuditWriteTask> Task = FAuditAssetUtils::LoadAndGather(Entry);
+		return Task.IsSet() && Task->Execute && Task->Execute()
+			&& FAuditWriteQueue::Get().WaitForWrite(Entry.AuditPath);
+	}
 
-	// --- Single-asset mode: write one audit file ---
-	if (!AssetPath.IsEmpty())
+	/** Copy the entry's audit from the shared cache, waiting for it to reach disk like AuditEntrySynchronously. */
+	bool RestoreEntryFromCache(const FStaleCheckEntry& Entry)
 	{
-		UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *AssetPath);
-		if (!BP)
-		{
-			// Try appending asset name for package-style paths like /Game/UI/WBP_Foo
-			const FString AssetName = FPackageName::GetShortName(AssetPath);
-			const FString FullPath = AssetPath + TEXT(".") + AssetName;
-			BP = LoadObject<UBlueprint>(nullptr, *FullPath);
-		}
+		return FAuditCache::Get().TryRestore(Entry) && FAuditWriteQueue::Get().WaitForWrite(Entry.AuditPath);
+	}
 
-		if (!BP)
+	/**
+	 * Resolve one line of a -ChangedFiles list to a long package name. Accepts package
+	 * paths (/Game/UI/WBP_Foo), object paths (/Game/UI/WBP_Foo.WBP_Foo), and on-disk
+	 * .uasset/.umap paths, absolute or relative to the project directory.
+	 */
+	FString ResolveChangedFileLine(const FString& Line)
+	{
+		const FString Extension = FPaths::GetExtension(Line, /*bIncludeDot=*/ true);
+		if (Extension == FPackageName::GetAssetPackageExtension() || Extension == FPackageName::GetMapPackageExtension())
 		{
-			UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Blueprint not found: %s"), *AssetPath);
-			return 1;
-		}
+			const FString AbsPath = FPaths::IsRelative(Line)
+				? FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Line)
+				: Line;
 
-		if (OutputPath.IsEmpty())
-		{
-			OutputPath = FPaths::ProjectDir() / TEXT("BlueprintAudit.md");
+			FString PackageName;
+			if (FPackageName::TryConvertFilenameToLongPackageName(AbsPath, PackageName))
+			{
+				return PackageName;
+			}
+
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Could not map %s to a package, skipping"), *Line);
+			return FString();
 		}
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing 1 Blueprint..."));
+		return FPackageName::ObjectPathToPackageName(Line);
+	}
 
-		const double StartTime = FPlatformTime::Seconds();
-		const FString AuditMarkdown = FBlueprintAuditor::AuditBlueprint(BP);
-		if (!FBlueprintAuditor::WriteAuditFile(AuditMarkdown, OutputPath))
+	/**
+	 * Build audit entries for the given packages. With bIncludeDependents, hard referencers
+	 * are followed breadth-first, but only through Blueprints and UserDefinedStructs: those
+	 * are the types whose changes alter the audits of their children and users.
+	 * OutUnsupported, if given, receives the requested packages that yield no entry.
+	 */
+	TArray<FStaleCheckEntry> CollectPackageEntries(IAssetRegistry& AssetRegistry, const TArray<FString>& Packages,
+		bool bIncludeDependents, int32& OutDependentCount, TArray<FString>* OutUnsupported = nullptr)
+	{
+		TArray<FStaleCheckEntry> Entries;
+		TSet<FString> Visited(Packages);
+		TArray<FString> Frontier = Packages;
+		OutDependentCount = 0;
+
+		for (int32 Index = 0; Index < Frontier.Num(); ++Index)
 		{
-			return 1;
-		}
-		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+			const FString PackageName = Frontier[Index];
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Audit complete, wrote %s in %.2fs"), *OutputPath, Elapsed);
-		return 0;
-	}
+			TArray<FAssetData> Assets;
+			AssetRegistry.GetAssetsByPackageName(FName(*PackageName), Assets, true);
 
-	// --- All-assets mode: write per-file audit under Saved/Fathom/Audit/Blueprints/ ---
-	TArray<FAssetData> AllBlueprints;
-	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), AllBlueprints, true);
+			bool bPropagates = false;
+			bool bAuditable = false;
+			for (const FAssetData& Asset : Assets)
+			{
+				FStaleCheckEntry Entry;
+				if (FAuditAssetUtils::TryMakeEntry(Asset, Entry))
+				{
+					bPropagates |= Entry.AssetType == EAuditAssetType::Blueprint
+						|| Entry.AssetType == EAuditAssetType::UserDefinedStruct;
+					bAuditable = true;
+					Entries.Add(MoveTemp(Entry));
+				}
+			}
 
-	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d Blueprint(s)..."), AllBlueprints.Num());
+			// Dependents were filtered by IsAuditablePackage; only the requested list is reported
+			if (!bAuditable && OutUnsupported && Index < Packages.Num())
+			{
+				OutUnsupported->Add(PackageName);
+			}
 
-	const double StartTime = FPlatformTime::Seconds();
-	int32 SuccessCount = 0;
-	int32 SkipCount = 0;
-	int32 FailCount = 0;
+			if (!bIncludeDependents || !bPropagates)
+			{
+				continue;
+			}
 
-	int32 AssetsSinceGC = 0;
-	constexpr int32 GCInterval = 50;
+			TArray<FName> Referencers;
+			AssetRegistry.GetReferencers(FName(*PackageName), Referencers,
+				UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
 
-	for (const FAssetData& Asset : AllBlueprints)
-	{
-		if (!FAuditFileUtils::IsAuditablePackage(Asset.PackageName.ToString()))
-		{
-			++SkipCount;
-			continue;
+			for (const FName& Referencer : Referencers)
+			{
+				const FString ReferencerName = Referencer.ToString();
+				if (!Visited.Contains(ReferencerName) && FAuditFileUtils::IsAuditablePackage(ReferencerName))
+				{
+					Visited.Add(ReferencerName);
+					Frontier.Add(ReferencerName);
+					++OutDependentCount;
+				}
+			}
 		}
 
-		if (!FBlueprintAuditor::IsSupportedBlueprintClass(Asset.AssetClassPath))
-		{
-			++SkipCount;
-			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Skipping unsupported Blueprint class %s (%s)"),
-				*Asset.PackageName.ToString(), *Asset.AssetClassPath.ToString());
-			continue;
-		}
+		return Entries;
+	}
 
-		UBlueprint* BP = Cast<UBlueprint>(Asset.GetAsset());
-		if (!BP)
+	/** Split a comma-separated -Paths value into package path roots without trailing slashes. */
+	TArray<FString> ParsePackagePaths(const FString& PathList)
+	{
+		TArray<FString> Paths;
+		PathList.ParseIntoArray(Paths, TEXT(","), /*InCullEmpty=*/ true);
+		for (FString& Path : Paths)
 		{
-			++FailCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load asset %s"), *Asset.PackageName.ToString());
-			continue;
+			Path.TrimStartAndEndInline();
+			while (Path.Len() > 1 && Path.EndsWith(TEXT("/")))
+			{
+				Path.LeftChopInline(1);
+			}
 		}
-
-		FString PerFilePath;
-		FString AuditMarkdown;
-#if FATHOM_HAS_CONTROLRIG_BLUEPRINT
-		if (const UControlRigBlueprint* CRBP = Cast<UControlRigBlueprint>(BP))
+		Paths.RemoveAll([](const FString& Path)
 		{
-			FControlRigAuditData Data = FBlueprintAuditor::GatherControlRigData(CRBP);
-			PerFilePath = Data.OutputPath;
-			AuditMarkdown = FBlueprintAuditor::SerializeControlRigToMarkdown(Data);
-		}
-		else
-#endif
+			if (!Path.StartsWith(TEXT("/")) || Path.Len() < 2)
+			{
+				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Ignoring invalid package path '%s' (expected e.g. /Game/UI)"), *Path);
+				return true;
+			}
+			return false;
+		});
+		return Paths;
+	}
+
+	/** True if PackageName is one of the roots or lives underneath one. */
+	bool IsUnderPackagePaths(const FString& PackageName, const TArray<FString>& PackagePaths)
+	{
+		for (const FString& Path : PackagePaths)
 		{
-			PerFilePath = FBlueprintAuditor::GetAuditOutputPath(BP);
-			AuditMarkdown = FBlueprintAuditor::AuditBlueprint(BP);
+			if (PackageName == Path || (PackageName.StartsWith(Path) && PackageName[Path.Len()] == TEXT('/')))
+			{
+				return true;
+			}
 		}
-		if (FBlueprintAuditor::WriteAuditFile(AuditMarkdown, PerFilePath))
+		return false;
+	}
+
+	/**
+	 * Write a registry-only stub for every entry that has no audit file yet, so a
+	 * long first run has something for every asset before the full pass gets to it.
+	 * Returns the number of stubs written.
+	 */
+	int32 WriteMissingStubs(IAssetRegistry& AssetRegistry, const TArray<FStaleCheckEntry>& Entries)
+	{
+		int32 Written = 0;
+		for (const FStaleCheckEntry& Entry : Entries)
 		{
-			++SuccessCount;
+			FAssetStubAuditData Stub;
+			if (FAuditAssetUtils::GatherStub(AssetRegistry, Entry, Stub) && FAuditAssetUtils::WriteStubIfMissing(Stub))
+			{
+				++Written;
+			}
 		}
-		else
+		return Written;
+	}
+
+	/** Prefix on every daemon response line, so clients can tell responses from log output on stdout. */
+	const TCHAR* const DaemonResponsePrefix = TEXT("FATHOM-DAEMON ");
+
+	/** Write one daemon response as a single prefixed line of condensed JSON on stdout. */
+	void WriteDaemonResponse(const TSharedRef<FJsonObject>& Json)
+	{
+		FString Body;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+		FJsonSerializer::Serialize(Json, Writer);
+
+		const FString ResponseLine = DaemonResponsePrefix + Body;
+		fprintf(stdout, "%s\n", TCHAR_TO_UTF8(*ResponseLine));
+		fflush(stdout);
+	}
+
+	/** Read one line (UTF-8) from stdin, trailing newline included. Returns false at end of input. */
+	bool ReadStdinLine(FString& OutLine)
+	{
+		TArray<ANSICHAR> Bytes;
+		ANSICHAR Chunk[1024];
+		while (fgets(Chunk, UE_ARRAY_COUNT(Chunk), stdin))
 		{
-			++FailCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write audit for %s"), *BP->GetName());
+			const int32 ChunkLen = FCStringAnsi::Strlen(Chunk);
+			Bytes.Append(Chunk, ChunkLen);
+			if (ChunkLen > 0 && Chunk[ChunkLen - 1] == '\n')
+			{
+				break;
+			}
 		}
 
-		if (++AssetsSinceGC >= GCInterval)
+		if (Bytes.IsEmpty())
 		{
-			CollectGarbage(RF_NoFlags);
-			AssetsSinceGC = 0;
+			return false;
 		}
+
+		Bytes.Add('\0');
+		OutLine = UTF8_TO_TCHAR(Bytes.GetData());
+		return true;
 	}
 
-	// --- DataTable batch ---
+	/**
+	 * Audit each entry inline. Without ClusterSizes, garbage is collected every GCInterval
+	 * assets. With them (see ClusterByDependencies), collection waits for a cluster boundary
+	 * once GCInterval assets have loaded, so a cluster's shared dependencies stay resident
+	 * for the whole cluster; ClusterGCHardCap still bounds memory inside oversized clusters.
+	 *
+	 * With a journal, packages a resumed run already completed and quarantined packages
+	 * are skipped, and every audited package is bracketed by begin/done journal lines.
+	 */
+	void AuditEntries(const TArray<FStaleCheckEntry>& Entries, UBlueprintAuditCommandlet::FRunStats& OutStats,
+		FAuditJournal* Journal, TConstArrayView<int32> ClusterSizes = {})
 	{
-		TArray<FAssetData> AllDataTables;
-		AssetRegistry.GetAssetsByClass(UDataTable::StaticClass()->GetClassPathName(), AllDataTables, false);
+		int32 AssetsSinceGC = 0;
+		int32 ClusterIndex = 0;
+		int32 ClusterEnd = ClusterSizes.IsEmpty() ? 0 : ClusterSizes[0];
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d DataTable(s)..."), AllDataTables.Num());
+		if (Journal)
+		{
+			Journal->RecordTotal(Entries.Num());
+		}
 
-		for (const FAssetData& Asset : AllDataTables)
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
 		{
-			if (!FAuditFileUtils::IsAuditablePackage(Asset.PackageName.ToString()))
+			const FStaleCheckEntry& Entry = Entries[Index];
+
+			if (Journal && Journal->IsCompleted(Entry.PackageName))
 			{
-				++SkipCount;
-				continue;
+				++OutStats.Skipped;
 			}
-
-			const UDataTable* DT = Cast<UDataTable>(Asset.GetAsset());
-			if (!DT)
+			else if (Journal && Journal->IsQuarantined(Entry.PackageName, Entry.SourcePath))
 			{
-				++FailCount;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load DataTable %s"), *Asset.PackageName.ToString());
-				continue;
+				++OutStats.Quarantined;
+				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Skipping quarantined %s"), *Entry.PackageName);
+			}
+			else
+			{
+				if (Journal)
+				{
+					Journal->BeginEntry(Entry.PackageName);
+				}
+
+				// Stale here may still be audited elsewhere: copy the shared cache's audit instead of loading
+				const bool bRestored = RestoreEntryFromCache(Entry);
+				if (bRestored)
+				{
+					++OutStats.Restored;
+				}
+				else if (FAuditCache::IsEnabled())
+				{
+					++OutStats.CacheMisses;
+				}
+
+				const bool bWritten = bRestored || AuditEntrySynchronously(Entry);
+				if (bWritten)
+				{
+					++OutStats.Written;
+				}
+				else
+				{
+					++OutStats.Failed;
+					UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to audit %s"), *Entry.PackageName);
+				}
+
+				if (Journal)
+				{
+					Journal->CompleteEntry(Entry.PackageName, bWritten);
+				}
+
+				++AssetsSinceGC;
 			}
 
-			FDataTableAuditData Data = FBlueprintAuditor::GatherDataTableData(DT);
-			const FString Markdown = FBlueprintAuditor::SerializeDataTableToMarkdown(Data);
-			if (FBlueprintAuditor::WriteAuditFile(Markdown, Data.OutputPath))
+			bool bCollect = false;
+			if (ClusterSizes.IsEmpty())
 			{
-				++SuccessCount;
+				bCollect = AssetsSinceGC >= GCInterval;
 			}
 			else
 			{
-				++FailCount;
+				const bool bClusterBoundary = Index + 1 == ClusterEnd;
+				if (bClusterBoundary && ++ClusterIndex < ClusterSizes.Num())
+				{
+					ClusterEnd += ClusterSizes[ClusterIndex];
+				}
+				bCollect = (bClusterBoundary && AssetsSinceGC >= GCInterval) || AssetsSinceGC >= ClusterGCHardCap;
 			}
 
-			if (++AssetsSinceGC >= GCInterval)
+			if (bCollect)
 			{
 				CollectGarbage(RF_NoFlags);
 				AssetsSinceGC = 0;
@@ -187,246 +331,694 @@ int32 UBlueprintAuditCommandlet::Main(const FString& Params)
 		}
 	}
 
-	// --- DataAsset batch ---
+	/**
+	 * Reorder Entries so assets that share a hard dependency run back to back. Each entry is
+	 * keyed by its most-shared direct dependency (fan-in counted across Entries); an entry
+	 * that is itself such a dependency anchors its own cluster and runs at its head. Returns
+	 * cluster sizes in run order: most-shared anchors first, then entries with no shared
+	 * dependency in GCInterval-sized chunks.
+	 */
+	TArray<int32> ClusterByDependencies(IAssetRegistry& AssetRegistry, TArray<FStaleCheckEntry>& Entries)
 	{
-		TArray<FAssetData> AllDataAssets;
-		AssetRegistry.GetAssetsByClass(UDataAsset::StaticClass()->GetClassPathName(), AllDataAssets, true);
+		TArray<TArray<FName>> EntryDependencies;
+		EntryDependencies.SetNum(Entries.Num());
+		TMap<FName, int32> DependencyFanIn;
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d DataAsset(s)..."), AllDataAssets.Num());
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			TArray<FName>& Dependencies = EntryDependencies[Index];
+			AssetRegistry.GetDependencies(FName(*Entries[Index].PackageName), Dependencies,
+				UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
 
-		const auto& Extensions = FAuditExtensionRegistry::Get().GetExtensions();
+			// Native /Script packages are never collected, so they don't cause reloads
+			Dependencies.RemoveAll([](const FName& Dependency)
+			{
+				return Dependency.ToString().StartsWith(TEXT("/Script/"));
+			});
 
-		for (const FAssetData& Asset : AllDataAssets)
-		{
-			if (!FAuditFileUtils::IsAuditablePackage(Asset.PackageName.ToString()))
+			for (const FName& Dependency : Dependencies)
 			{
-				++SkipCount;
-				continue;
+				++DependencyFanIn.FindOrAdd(Dependency);
 			}
+		}
+
+		TMap<FName, TArray<int32>> Clusters;
+		TArray<int32> Unclustered;
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			const FName PackageName(*Entries[Index].PackageName);
+			const int32* OwnFanIn = DependencyFanIn.Find(PackageName);
 
-			// Skip assets handled by extension auditors (e.g. StateTree inherits UDataAsset)
-			bool bHandledByExtension = false;
-			for (const auto& Ext : Extensions)
+			FName Anchor = (OwnFanIn && *OwnFanIn > 1) ? PackageName : NAME_None;
+			int32 AnchorFanIn = Anchor.IsNone() ? 1 : *OwnFanIn;
+			for (const FName& Dependency : EntryDependencies[Index])
 			{
-				if (Ext.IsHandledAsset && Ext.IsHandledAsset(Asset))
+				const int32 FanIn = DependencyFanIn[Dependency];
+				if (FanIn > AnchorFanIn)
 				{
-					bHandledByExtension = true;
-					break;
+					Anchor = Dependency;
+					AnchorFanIn = FanIn;
 				}
 			}
-			if (bHandledByExtension)
-			{
-				continue;
-			}
 
-			const UDataAsset* DA = Cast<UDataAsset>(Asset.GetAsset());
-			if (!DA)
+			if (Anchor.IsNone())
 			{
-				++FailCount;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load DataAsset %s"), *Asset.PackageName.ToString());
-				continue;
+				Unclustered.Add(Index);
 			}
-
-			FDataAssetAuditData Data = FBlueprintAuditor::GatherDataAssetData(DA);
-			const FString Markdown = FBlueprintAuditor::SerializeDataAssetToMarkdown(Data);
-			if (FBlueprintAuditor::WriteAuditFile(Markdown, Data.OutputPath))
+			else if (Anchor == PackageName)
 			{
-				++SuccessCount;
+				Clusters.FindOrAdd(Anchor).Insert(Index, 0);
 			}
 			else
 			{
-				++FailCount;
+				Clusters.FindOrAdd(Anchor).Add(Index);
 			}
+		}
 
-			if (++AssetsSinceGC >= GCInterval)
+		TArray<FName> AnchorOrder;
+		Clusters.GenerateKeyArray(AnchorOrder);
+		AnchorOrder.Sort([&DependencyFanIn](const FName& A, const FName& B)
+		{
+			const int32 FanInA = DependencyFanIn[A];
+			const int32 FanInB = DependencyFanIn[B];
+			return FanInA != FanInB ? FanInA > FanInB : A.LexicalLess(B);
+		});
+
+		TArray<FStaleCheckEntry> Ordered;
+		Ordered.Reserve(Entries.Num());
+		TArray<int32> ClusterSizes;
+
+		for (const FName& Anchor : AnchorOrder)
+		{
+			const TArray<int32>& Members = Clusters[Anchor];
+			for (const int32 Index : Members)
 			{
-				CollectGarbage(RF_NoFlags);
-				AssetsSinceGC = 0;
+				Ordered.Add(MoveTemp(Entries[Index]));
 			}
+			ClusterSizes.Add(Members.Num());
 		}
+
+		for (int32 Start = 0; Start < Unclustered.Num(); Start += GCInterval)
+		{
+			const int32 End = FMath::Min(Start + GCInterval, Unclustered.Num());
+			for (int32 Position = Start; Position < End; ++Position)
+			{
+				Ordered.Add(MoveTemp(Entries[Unclustered[Position]]));
+			}
+			ClusterSizes.Add(End - Start);
+		}
+
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Scheduled %d asset(s) into %d dependency cluster(s), %d unclustered"),
+			Entries.Num(), AnchorOrder.Num(), Unclustered.Num());
+
+		Entries = MoveTemp(Ordered);
+		return ClusterSizes;
 	}
 
-	// --- UserDefinedStruct batch ---
+	/** Audit Entries in registry order, or clustered by shared dependencies when requested. */
+	void AuditEntriesScheduled(IAssetRegistry& AssetRegistry, TArray<FStaleCheckEntry>& Entries, bool bClusterByDependencies,
+		UBlueprintAuditCommandlet::FRunStats& OutStats, FAuditJournal* Journal)
 	{
-		TArray<FAssetData> AllStructs;
-		AssetRegistry.GetAssetsByClass(UUserDefinedStruct::StaticClass()->GetClassPathName(), AllStructs, false);
+		if (!bClusterByDependencies)
+		{
+			AuditEntries(Entries, OutStats, Journal);
+			return;
+		}
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d UserDefinedStruct(s)..."), AllStructs.Num());
+		const TArray<int32> ClusterSizes = ClusterByDependencies(AssetRegistry, Entries);
+		AuditEntries(Entries, OutStats, Journal, ClusterSizes);
+	}
 
-		for (const FAssetData& Asset : AllStructs)
-		{
-			if (!FAuditFileUtils::IsAuditablePackage(Asset.PackageName.ToString()))
-			{
-				++SkipCount;
-				continue;
-			}
+	/** Command-line switches the supervisor sets itself on each child launch. */
+	bool IsSupervisorSwitch(const FString& Token)
+	{
+		return Token.Equals(TEXT("-Supervise"), ESearchCase::IgnoreCase)
+			|| Token.Equals(TEXT("-Resume"), ESearchCase::IgnoreCase)
+			|| Token.StartsWith(TEXT("-Journal="), ESearchCase::IgnoreCase)
+			|| Token.StartsWith(TEXT("-MaxRestarts="), ESearchCase::IgnoreCase);
+	}
 
-			const UUserDefinedStruct* UDS = Cast<UUserDefinedStruct>(Asset.GetAsset());
-			if (!UDS)
+	/** Rebuild a command line from the current one, dropping supervisor switches and re-quoting values with spaces. */
+	FString BuildChildCommandLine()
+	{
+		FString ChildCommandLine;
+		const TCHAR* Stream = FCommandLine::Get();
+		FString Token;
+		while (FParse::Token(Stream, Token, /*bUseEscape=*/ false))
+		{
+			if (IsSupervisorSwitch(Token))
 			{
-				++FailCount;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load UserDefinedStruct %s"), *Asset.PackageName.ToString());
 				continue;
 			}
 
-			FUserDefinedStructAuditData Data = FBlueprintAuditor::GatherUserDefinedStructData(UDS);
-			const FString Markdown = FBlueprintAuditor::SerializeUserDefinedStructToMarkdown(Data);
-			if (FBlueprintAuditor::WriteAuditFile(Markdown, Data.OutputPath))
+			if (Token.Contains(TEXT(" ")))
 			{
-				++SuccessCount;
-			}
-			else
-			{
-				++FailCount;
+				FString Key;
+				FString Value;
+				Token = Token.Split(TEXT("="), &Key, &Value)
+					? FString::Printf(TEXT("%s=\"%s\""), *Key, *Value)
+					: FString::Printf(TEXT("\"%s\""), *Token);
 			}
 
-			if (++AssetsSinceGC >= GCInterval)
-			{
-				CollectGarbage(RF_NoFlags);
-				AssetsSinceGC = 0;
-			}
+			ChildCommandLine += ChildCommandLine.IsEmpty() ? Token : TEXT(" ") + Token;
 		}
+		return ChildCommandLine;
 	}
+}
+
+UBlueprintAuditCommandlet::UBlueprintAuditCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBlueprintAuditCommandlet::Main(const FString& Params)
+{
+	// Parse parameters. -AssetPath takes a comma-separated list, so don't stop at separators.
+	FString AssetPath;
+	FParse::Value(*Params, TEXT("-AssetPath="), AssetPath, /*bShouldStopOnSeparator=*/ false);
+
+	FString OutputPath;
+	FParse::Value(*Params, TEXT("-Output="), OutputPath);
 
-	// --- Material batch ---
+	FString ChangedFilesPath;
+	FParse::Value(*Params, TEXT("-ChangedFiles="), ChangedFilesPath);
+
+	FString PathList;
+	FParse::Value(*Params, TEXT("-Paths="), PathList, /*bShouldStopOnSeparator=*/ false);
+	const TArray<FString> PackagePaths = ParsePackagePaths(PathList);
+
+	// -Schedule=Dependencies clusters assets by shared hard dependencies; the default keeps registry order
+	FString Schedule;
+	FParse::Value(*Params, TEXT("-Schedule="), Schedule);
+	bClusterByDependencies = Schedule.Equals(TEXT("Dependencies"), ESearchCase::IgnoreCase);
+	if (!Schedule.IsEmpty() && !bClusterByDependencies && !Schedule.Equals(TEXT("Registry"), ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Unknown -Schedule=%s (expected Registry or Dependencies), using Registry"), *Schedule);
+	}
+
+	// --- Supervisor mode: run the audit in a child process, resuming past crashes ---
+	if (FParse::Param(*Params, TEXT("Supervise")))
+	{
+		return RunSupervisor(Params);
+	}
+
+	// -Journal records progress so a crashed run can be resumed with -Resume
+	FString JournalPath;
+	FParse::Value(*Params, TEXT("-Journal="), JournalPath);
+	const bool bResume = FParse::Param(*Params, TEXT("Resume"));
+	if (bResume && JournalPath.IsEmpty())
+	{
+		JournalPath = FAuditJournal::GetDefaultJournalPath();
+	}
+	Journal.Open(JournalPath, bResume);
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	// --- Daemon mode: initialize once, then serve jobs from stdin until quit or EOF ---
+	if (FParse::Param(*Params, TEXT("Daemon")))
+	{
+		return RunDaemon(AssetRegistry);
+	}
+
+	FRunStats Stats;
+	int32 ExitCode = 0;
+
+	if (!ChangedFilesPath.IsEmpty())
 	{
-		TArray<FAssetData> AllMaterials;
-		AssetRegistry.GetAssetsByClass(UMaterial::StaticClass()->GetClassPathName(), AllMaterials, false);
+		// --- Changed-files mode: scans only what it needs, so it runs before the full registry search ---
+		ExitCode = RunChangedFilesMode(AssetRegistry, ChangedFilesPath, FParse::Param(*Params, TEXT("IncludeDependents")), Stats);
+	}
+	else if (!AssetPath.IsEmpty())
+	{
+		// --- Asset-list mode: audit the named assets only ---
+		ExitCode = RunAssetListMode(AssetRegistry, AssetPath, OutputPath, Stats);
+	}
+	else
+	{
+		// --- All-assets mode: write per-file audit under Saved/Fathom/Audit/ ---
+		ExitCode = RunAllAssetsMode(AssetRegistry, PackagePaths, Stats);
+	}
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d Material(s)..."), AllMaterials.Num());
+	Journal.Finish();
 
-		for (const FAssetData& Asset : AllMaterials)
+	const FAuditWriteStats WriteStats = FAuditFileUtils::GetWriteStats();
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: %lld audit file(s) written (%lld migrated and %lld copied from the shared cache without a load), %lld unchanged and skipped, %lld failed"),
+		WriteStats.Written, WriteStats.Migrated, WriteStats.Cached, WriteStats.Unchanged, WriteStats.Failed);
+	return ExitCode;
+}
+
+int32 UBlueprintAuditCommandlet::RunAllAssetsMode(IAssetRegistry& AssetRegistry, const TArray<FString>& PackagePaths, FRunStats& OutStats)
+{
+	// With -Paths, only the requested roots are scanned and audited
+	if (PackagePaths.IsEmpty())
+	{
+		AssetRegistry.SearchAllAssets(true);
+	}
+	else
+	{
+		AssetRegistry.ScanPathsSynchronous(PackagePaths);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FStaleCheckEntry> Entries;
+	FAuditAssetUtils::CollectEntries(AssetRegistry, Entries);
+	if (!PackagePaths.IsEmpty())
+	{
+		// The registry can hold assets from outside the scanned roots (engine content, preloaded packages)
+		Entries.RemoveAll([&PackagePaths](const FStaleCheckEntry& Entry)
 		{
-			if (!FAuditFileUtils::IsAuditablePackage(Asset.PackageName.ToString()))
-			{
-				++SkipCount;
-				continue;
-			}
+			return !IsUnderPackagePaths(Entry.PackageName, PackagePaths);
+		});
+	}
 
-			const UMaterial* Mat = Cast<UMaterial>(Asset.GetAsset());
-			if (!Mat)
-			{
-				++FailCount;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load Material %s"), *Asset.PackageName.ToString());
-				continue;
-			}
+	const int32 StubCount = WriteMissingStubs(AssetRegistry, Entries);
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Wrote %d stub audit(s) in %.2fs"), StubCount, FPlatformTime::Seconds() - StartTime);
 
-			FMaterialAuditData Data = FMaterialAuditor::GatherData(Mat);
-			const FString Markdown = FMaterialAuditor::SerializeToMarkdown(Data);
-			if (FBlueprintAuditor::WriteAuditFile(Markdown, Data.OutputPath))
-			{
-				++SuccessCount;
-			}
-			else
-			{
-				++FailCount;
-			}
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d asset(s)..."), Entries.Num());
+
+	AuditEntriesScheduled(AssetRegistry, Entries, bClusterByDependencies, OutStats, &Journal);
+
+	FAuditFileUtils::WriteAuditManifest();
 
-			if (++AssetsSinceGC >= GCInterval)
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Audit complete, %d written, %d resumed, %d quarantined, %d failed in %.2fs"),
+		OutStats.Written, OutStats.Skipped, OutStats.Quarantined, OutStats.Failed, Elapsed);
+	return 0;
+}
+
+int32 UBlueprintAuditCommandlet::RunChangedFilesMode(IAssetRegistry& AssetRegistry, const FString& ListPath, bool bIncludeDependents, FRunStats& OutStats)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *ListPath))
+	{
+		UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Failed to read changed-files list %s"), *ListPath);
+		return 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Split the list into packages still on disk and packages the change removed
+	TArray<FString> ChangedPackages;
+	TArray<FString> ChangedFiles;
+	TArray<FString> RemovedPackages;
+	for (FString Line : Lines)
+	{
+		Line.TrimStartAndEndInline();
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		const FString PackageName = ResolveChangedFileLine(Line);
+		if (PackageName.IsEmpty() || !FAuditFileUtils::IsAuditablePackage(PackageName))
+		{
+			continue;
+		}
+
+		FString Filename;
+		if (FPackageName::DoesPackageExist(PackageName, &Filename))
+		{
+			if (!ChangedPackages.Contains(PackageName))
 			{
-				CollectGarbage(RF_NoFlags);
-				AssetsSinceGC = 0;
+				ChangedPackages.Add(PackageName);
+				ChangedFiles.Add(Filename);
 			}
 		}
+		else
+		{
+			RemovedPackages.AddUnique(PackageName);
+		}
 	}
 
-	// --- MaterialInstance batch ---
+	// Dependent expansion walks the referencer graph, which needs the full registry.
+	// Without it, only the changed files have to be scanned. The changed files are
+	// force-rescanned either way so a resident daemon sees edits made since its first scan.
+	if (bIncludeDependents)
 	{
-		TArray<FAssetData> AllMaterialInstances;
-		AssetRegistry.GetAssetsByClass(UMaterialInstanceConstant::StaticClass()->GetClassPathName(), AllMaterialInstances, false);
+		AssetRegistry.SearchAllAssets(true);
+	}
+	AssetRegistry.ScanFilesSynchronous(ChangedFiles, /*bForceRescan=*/ true);
+
+	int32 DependentCount = 0;
+	TArray<FStaleCheckEntry> Entries = CollectPackageEntries(AssetRegistry, ChangedPackages, bIncludeDependents, DependentCount);
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d MaterialInstance(s)..."), AllMaterialInstances.Num());
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d asset(s) from %d changed and %d dependent package(s)..."),
+		Entries.Num(), ChangedPackages.Num(), DependentCount);
 
-		for (const FAssetData& Asset : AllMaterialInstances)
+	AuditEntriesScheduled(AssetRegistry, Entries, bClusterByDependencies, OutStats, &Journal);
+
+	for (const FString& PackageName : RemovedPackages)
+	{
+		const FString AuditPath = FAuditFileUtils::GetAuditOutputPath(PackageName);
+		if (FAuditFileUtils::AuditFileExists(AuditPath) && FAuditFileUtils::DeleteAuditFile(AuditPath))
 		{
-			if (!FAuditFileUtils::IsAuditablePackage(Asset.PackageName.ToString()))
-			{
-				++SkipCount;
-				continue;
-			}
+			++OutStats.Deleted;
+		}
+	}
 
-			const UMaterialInstanceConstant* MI = Cast<UMaterialInstanceConstant>(Asset.GetAsset());
-			if (!MI)
-			{
-				++FailCount;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load MaterialInstance %s"), *Asset.PackageName.ToString());
-				continue;
-			}
+	FAuditFileUtils::WriteAuditManifest();
 
-			FMaterialAuditData Data = FMaterialAuditor::GatherData(MI);
-			const FString Markdown = FMaterialAuditor::SerializeToMarkdown(Data);
-			if (FBlueprintAuditor::WriteAuditFile(Markdown, Data.OutputPath))
-			{
-				++SuccessCount;
-			}
-			else
-			{
-				++FailCount;
-			}
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Changed-files audit complete, %d written, %d deleted, %d quarantined, %d failed in %.2fs"),
+		OutStats.Written, OutStats.Deleted, OutStats.Quarantined, OutStats.Failed, Elapsed);
+	return OutStats.Failed > 0 ? 1 : 0;
+}
 
-			if (++AssetsSinceGC >= GCInterval)
-			{
-				CollectGarbage(RF_NoFlags);
-				AssetsSinceGC = 0;
-			}
+int32 UBlueprintAuditCommandlet::RunAssetListMode(IAssetRegistry& AssetRegistry, const FString& AssetPathList, const FString& OutputPath, FRunStats& OutStats)
+{
+	TArray<FString> RequestedPaths;
+	AssetPathList.ParseIntoArray(RequestedPaths, TEXT(","), /*InCullEmpty=*/ true);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FString> Packages;
+	TArray<FString> Files;
+	for (FString Path : RequestedPaths)
+	{
+		Path.TrimStartAndEndInline();
+		const FString PackageName = FPackageName::ObjectPathToPackageName(Path);
+
+		FString Filename;
+		if (!FPackageName::IsValidLongPackageName(PackageName) || !FPackageName::DoesPackageExist(PackageName, &Filename))
+		{
+			++OutStats.NotFound;
+			UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Asset not found: %s"), *Path);
+			continue;
+		}
+
+		if (!Packages.Contains(PackageName))
+		{
+			Packages.Add(PackageName);
+			Files.Add(Filename);
 		}
 	}
 
-	// BehaviorTree batch
+	// Only the requested files need to be in the registry. Forced so a resident
+	// daemon picks up edits made since its first scan.
+	AssetRegistry.ScanFilesSynchronous(Files, /*bForceRescan=*/ true);
+
+	int32 DependentCount = 0;
+	TArray<FString> UnsupportedPackages;
+	const TArray<FStaleCheckEntry> Entries = CollectPackageEntries(AssetRegistry, Packages, /*bIncludeDependents=*/ false,
+		DependentCount, &UnsupportedPackages);
+
+	// Packages that exist but hold nothing an auditor handles (e.g. a map or a texture)
+	OutStats.Unsupported = UnsupportedPackages.Num();
+	for (const FString& PackageName : UnsupportedPackages)
 	{
-		TArray<FAssetData> AllBTs;
-		AssetRegistry.GetAssetsByClass(UBehaviorTree::StaticClass()->GetClassPathName(), AllBTs, false);
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Not an auditable type: %s"), *PackageName);
+	}
+
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d asset(s)..."), Entries.Num());
+
+	// Explicitly requested assets are audited even if quarantined
+	AuditEntries(Entries, OutStats, nullptr);
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d BehaviorTree(s)..."), AllBTs.Num());
+	// Flushes the write-behind queue, so the audit is on disk for the copy below
+	FAuditFileUtils::WriteAuditManifest();
 
-		for (const FAssetData& Asset : AllBTs)
+	// Legacy single-asset form: also copy the audit to -Output
+	if (!OutputPath.IsEmpty())
+	{
+		if (Entries.Num() != 1 || RequestedPaths.Num() != 1)
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: -Output is only used with a single -AssetPath, ignoring"));
+		}
+		else if (OutStats.Written == 1)
 		{
-			if (!FAuditFileUtils::IsAuditablePackage(Asset.PackageName.ToString()))
+			// Decompressed when audits are stored as .md.gz
+			FString Content;
+			if (!FAuditFileUtils::LoadAuditFile(Entries[0].AuditPath, Content)
+				|| !FFileHelper::SaveStringToFile(Content, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
 			{
-				++SkipCount;
-				continue;
+				++OutStats.Failed;
+				UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Failed to copy audit to %s"), *OutputPath);
 			}
+		}
+	}
 
-			const UBehaviorTree* BT = Cast<UBehaviorTree>(Asset.GetAsset());
-			if (!BT)
-			{
-				++FailCount;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load BehaviorTree %s"), *Asset.PackageName.ToString());
-				continue;
-			}
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Asset audit complete, %d written, %d not found, %d unsupported, %d failed in %.2fs"),
+		OutStats.Written, OutStats.NotFound, OutStats.Unsupported, OutStats.Failed, Elapsed);
+
+	return (OutStats.NotFound > 0 || OutStats.Unsupported > 0 || OutStats.Failed > 0) ? 1 : 0;
+}
+
+int32 UBlueprintAuditCommandlet::RunSweep(IAssetRegistry& AssetRegistry, const TArray<FString>& PackagePaths, FRunStats& OutStats)
+{
+	const double StartTime = FPlatformTime::Seconds();
 
-			FBehaviorTreeAuditData Data = FBehaviorTreeAuditor::GatherData(BT);
-			const FString Markdown = FBehaviorTreeAuditor::SerializeToMarkdown(Data);
-			if (FBlueprintAuditor::WriteAuditFile(Markdown, Data.OutputPath))
+	// Rescan the requested roots (default: every auditable content root) so assets
+	// added, edited or deleted on disk since the registry was last searched are reflected
+	TArray<FString> RootPaths = PackagePaths;
+	if (RootPaths.IsEmpty())
+	{
+		FPackageName::QueryRootContentPaths(RootPaths);
+		RootPaths.RemoveAll([](const FString& Root) { return !FAuditFileUtils::IsAuditablePackage(Root); });
+	}
+	AssetRegistry.ScanPathsSynchronous(RootPaths, /*bForceRescan=*/ true);
+
+	TArray<FStaleCheckEntry> Entries;
+	FAuditAssetUtils::CollectEntries(AssetRegistry, Entries);
+	if (!PackagePaths.IsEmpty())
+	{
+		Entries.RemoveAll([&PackagePaths](const FStaleCheckEntry& Entry)
+		{
+			return !IsUnderPackagePaths(Entry.PackageName, PackagePaths);
+		});
+	}
+
+	TArray<FStaleCheckEntry> StaleEntries;
+	TArray<FStaleCheckEntry> MigratedEntries;
+	for (const FStaleCheckEntry& Entry : Entries)
+	{
+		switch (FAuditAssetUtils::GetAuditStaleness(Entry))
+		{
+		case EAuditStaleness::Stale:
+			StaleEntries.Add(Entry);
+			break;
+		case EAuditStaleness::NeedsMigration:
+			// Format-only gap: rewritten as text; one that no longer migrates is re-audited
+			if (FAuditAssetUtils::MigrateAudit(Entry))
 			{
-				++SuccessCount;
+				MigratedEntries.Add(Entry);
 			}
 			else
 			{
-				++FailCount;
-			}
-
-			if (++AssetsSinceGC >= GCInterval)
-			{
-				CollectGarbage(RF_NoFlags);
-				AssetsSinceGC = 0;
+				StaleEntries.Add(Entry);
 			}
+			break;
+		default:
+			break;
 		}
 	}
 
-	// Extension auditors (e.g. StateTree)
-	for (const auto& Ext : FAuditExtensionRegistry::Get().GetExtensions())
+	// One drain for every migration, then only those on disk count
+	FAuditWriteQueue::Get().Flush();
+	for (const FStaleCheckEntry& Entry : MigratedEntries)
 	{
-		if (Ext.BatchAudit)
+		if (FAuditWriteQueue::Get().WaitForWrite(Entry.AuditPath))
+		{
+			++OutStats.Migrated;
+		}
+		else
 		{
-			Ext.BatchAudit(AssetRegistry, SuccessCount, FailCount, SkipCount);
+			StaleEntries.Add(Entry);
 		}
 	}
 
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Sweep found %d stale of %d asset(s), %d migrated"),
+		StaleEntries.Num(), Entries.Num(), OutStats.Migrated);
+
+	AuditEntriesScheduled(AssetRegistry, StaleEntries, bClusterByDependencies, OutStats, &Journal);
+
+	// The orphan sweep judges every audit file against the registry, so it only runs unscoped
+	if (PackagePaths.IsEmpty())
+	{
+		OutStats.Deleted = FAuditAssetUtils::SweepOrphanedAuditFiles(AssetRegistry, FAuditFileUtils::GetAuditBaseDir());
+	}
+
 	FAuditFileUtils::WriteAuditManifest();
 
 	const double Elapsed = FPlatformTime::Seconds() - StartTime;
-	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Audit complete, %d written, %d skipped, %d failed in %.2fs"),
-		SuccessCount, SkipCount, FailCount, Elapsed);
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Sweep complete, %d written (%d from the shared cache, %d not found there), %d migrated, %d deleted, %d quarantined, %d failed in %.2fs"),
+		OutStats.Written, OutStats.Restored, OutStats.CacheMisses, OutStats.Migrated, OutStats.Deleted, OutStats.Quarantined, OutStats.Failed, Elapsed);
+	return OutStats.Failed > 0 ? 1 : 0;
+}
+
+int32 UBlueprintAuditCommandlet::RunDaemon(IAssetRegistry& AssetRegistry)
+{
+	AssetRegistry.SearchAllAssets(true);
+
+	const double DaemonStartTime = FPlatformTime::Seconds();
+	int32 JobCount = 0;
+
+	{
+		TSharedRef<FJsonObject> Ready = MakeShared<FJsonObject>();
+		Ready->SetStringField(TEXT("event"), TEXT("ready"));
+		Ready->SetNumberField(TEXT("schemaVersion"), FAuditFileUtils::AuditSchemaVersion);
+		Ready->SetStringField(TEXT("auditDir"), FAuditFileUtils::GetAuditBaseDir());
+		WriteDaemonResponse(Ready);
+	}
+
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Audit daemon ready, reading jobs from stdin"));
+
+	FString Line;
+	while (!IsEngineExitRequested() && ReadStdinLine(Line))
+	{
+		Line.TrimStartAndEndInline();
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		FString Command;
+		FString Args;
+		if (!Line.Split(TEXT(" "), &Command, &Args))
+		{
+			Command = Line;
+		}
+		Args.TrimStartAndEndInline();
+
+		TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetNumberField(TEXT("job"), ++JobCount);
+		Response->SetStringField(TEXT("command"), Command);
+
+		const double JobStartTime = FPlatformTime::Seconds();
+		FRunStats Stats;
+		int32 ExitCode = 0;
+		bool bRanAudit = true;
+
+		if (Command == TEXT("audit") && !Args.IsEmpty())
+		{
+			ExitCode = RunAssetListMode(AssetRegistry, Args, FString(), Stats);
+		}
+		else if (Command == TEXT("changed") && !Args.IsEmpty())
+		{
+			FString ListPath = Args;
+			const bool bIncludeDependents = ListPath.RemoveFromEnd(TEXT(" dependents"));
+			ExitCode = RunChangedFilesMode(AssetRegistry, ListPath.TrimEnd(), bIncludeDependents, Stats);
+		}
+		else if (Command == TEXT("sweep"))
+		{
+			ExitCode = RunSweep(AssetRegistry, ParsePackagePaths(Args), Stats);
+		}
+		else if (Command == TEXT("status"))
+		{
+			bRanAudit = false;
+			Response->SetBoolField(TEXT("ok"), true);
+			Response->SetNumberField(TEXT("uptimeSeconds"), FPlatformTime::Seconds() - DaemonStartTime);
+			Response->SetNumberField(TEXT("jobs"), JobCount);
+			Response->SetNumberField(TEXT("schemaVersion"), FAuditFileUtils::AuditSchemaVersion);
+			Response->SetStringField(TEXT("auditDir"), FAuditFileUtils::GetAuditBaseDir());
+		}
+		else if (Command == TEXT("quit"))
+		{
+			Response->SetBoolField(TEXT("ok"), true);
+			WriteDaemonResponse(Response);
+			break;
+		}
+		else
+		{
+			bRanAudit = false;
+			Response->SetBoolField(TEXT("ok"), false);
+			Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown or incomplete command: %s"), *Line));
+			Response->SetStringField(TEXT("usage"), TEXT("audit <path>[,<path>...] | changed <list.txt> [dependents] | sweep [<root>[,<root>...]] | status | quit"));
+		}
+
+		if (bRanAudit)
+		{
+			Response->SetBoolField(TEXT("ok"), ExitCode == 0);
+			Response->SetNumberField(TEXT("written"), Stats.Written);
+			Response->SetNumberField(TEXT("migrated"), Stats.Migrated);
+			Response->SetNumberField(TEXT("restored"), Stats.Restored);
+			Response->SetNumberField(TEXT("cacheMisses"), Stats.CacheMisses);
+			Response->SetNumberField(TEXT("deleted"), Stats.Deleted);
+			Response->SetNumberField(TEXT("notFound"), Stats.NotFound);
+			Response->SetNumberField(TEXT("unsupported"), Stats.Unsupported);
+			Response->SetNumberField(TEXT("failed"), Stats.Failed);
+			Response->SetNumberField(TEXT("quarantined"), Stats.Quarantined);
+			Response->SetNumberField(TEXT("elapsedMs"), FMath::RoundToInt((FPlatformTime::Seconds() - JobStartTime) * 1000.0));
+
+			// Jobs load assets; release them so a long-lived daemon doesn't grow without bound
+			CollectGarbage(RF_NoFlags);
+		}
+
+		WriteDaemonResponse(Response);
+	}
+
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Audit daemon exiting after %d job(s)"), JobCount);
 	return 0;
 }
+
+int32 UBlueprintAuditCommandlet::RunSupervisor(const FString& Params)
+{
+	FString JournalPath;
+	if (!FParse::Value(*Params, TEXT("-Journal="), JournalPath))
+	{
+		JournalPath = FAuditJournal::GetDefaultJournalPath();
+	}
+
+	int32 MaxRestarts = DefaultMaxRestarts;
+	FParse::Value(*Params, TEXT("-MaxRestarts="), MaxRestarts);
+
+	const FString ExecutablePath = FPlatformProcess::ExecutablePath();
+	const FString ChildCommandLine = BuildChildCommandLine();
+	bool bResume = FParse::Param(*Params, TEXT("Resume"));
+	int32 Restarts = 0;
+
+	for (;;)
+	{
+		const FString ChildArgs = FString::Printf(TEXT("%s -Journal=\"%s\"%s"),
+			*ChildCommandLine, *JournalPath, bResume ? TEXT(" -Resume") : TEXT(""));
+
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Supervisor launching audit process%s"), bResume ? TEXT(" (resume)") : TEXT(""));
+
+		FProcHandle Proc = FPlatformProcess::CreateProc(*ExecutablePath, *ChildArgs,
+			/*bLaunchDetached=*/ false, /*bLaunchHidden=*/ true, /*bLaunchReallyHidden=*/ true,
+			nullptr, 0, nullptr, nullptr);
+		if (!Proc.IsValid())
+		{
+			UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Supervisor failed to launch %s"), *ExecutablePath);
+			return 1;
+		}
+
+		FPlatformProcess::WaitForProc(Proc);
+		int32 ChildExitCode = 1;
+		FPlatformProcess::GetProcReturnCode(Proc, &ChildExitCode);
+		FPlatformProcess::CloseProc(Proc);
+
+		const FAuditJournal::FSummary Summary = FAuditJournal::ReadSummary(JournalPath);
+		if (Summary.bFinished)
+		{
+			UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Supervised audit finished after %d restart(s), %d quarantined"),
+				Restarts, Summary.Quarantined);
+			return ChildExitCode;
+		}
+
+		// Without an in-flight package there is nothing to quarantine, so a restart
+		// would crash the same way (e.g. during engine startup)
+		if (Summary.InFlightPackage.IsEmpty())
+		{
+			UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Audit process exited with code %d outside any asset audit, not restarting"),
+				ChildExitCode);
+			return 1;
+		}
+
+		if (++Restarts > MaxRestarts)
+		{
+			UE_LOG(LogFathomUELink, Error, TEXT("Fathom: Audit process crashed %d time(s), giving up (-MaxRestarts=%d)"),
+				Restarts, MaxRestarts);
+			return 1;
+		}
+
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Audit process exited with code %d while auditing %s, quarantining it and resuming (%d/%d done)"),
+			ChildExitCode, *Summary.InFlightPackage, Summary.Completed, Summary.Total);
+		bResume = true;
+	}
+}
@@ -2,7 +2,6 @@
 
 #include "BlueprintAuditor.h"
 #include "FathomUELinkModule.h"
-#include "Async/Async.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/Blueprint.h"
 #include "Engine/DataAsset.h"
@@ -12,7 +11,15 @@
 #include "HAL/FileManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Audit/AssetStubAuditor.h"
+#include "Audit/AuditCache.h"
+#include "Audit/AuditCompactBinary.h"
+#include "Audit/AuditAssetUtils.h"
 #include "Audit/AuditFileUtils.h"
+#include "Audit/AuditIndex.h"
+#include "Audit/AuditPackStore.h"
+#include "Audit/AuditThreadPool.h"
 #include "Audit/MaterialAuditor.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInstance.h"
@@ -22,6 +29,35 @@
 #include "UObject/ObjectSaveContext.h"
 #include "Misc/App.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Editor.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "Audit/AuditJournal.h"
+#include "FathomAuditSettings.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+namespace
+{
+	FString GetOffloadListPath()
+	{
+		return FPaths::ConvertRelativePathToFull(
+			FPaths::ProjectDir() / TEXT("Saved") / TEXT("Fathom") / TEXT("stale-reaudit-list.txt"));
+	}
+
+	FString GetOffloadJournalPath()
+	{
+		return FPaths::ConvertRelativePathToFull(
+			FPaths::ProjectDir() / TEXT("Saved") / TEXT("Fathom") / TEXT("stale-reaudit-journal.txt"));
+	}
+
+	/** Packages whose audit was still pending at shutdown, one per line; consumed on the next launch. */
+	FString GetResumeQueuePath()
+	{
+		return FPaths::ConvertRelativePathToFull(
+			FPaths::ProjectDir() / TEXT("Saved") / TEXT("Fathom") / TEXT("audit-resume-queue.txt"));
+	}
+}
 
 void UBlueprintAuditSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -42,12 +78,37 @@ void UBlueprintAuditSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	AssetRegistry.OnAssetRemoved().AddUObject(this, &UBlueprintAuditSubsystem::OnAssetRemoved);
 	AssetRegistry.OnAssetRenamed().AddUObject(this, &UBlueprintAuditSubsystem::OnAssetRenamed);
 
+	FEditorDelegates::BeginPIE.AddUObject(this, &UBlueprintAuditSubsystem::OnBeginPIE);
+	FEditorDelegates::EndPIE.AddUObject(this, &UBlueprintAuditSubsystem::OnEndPIE);
+
+	LoadResumeQueue();
+
+	// First run with the packed store enabled: seed it from the existing .md tree
+	if (FAuditPackStore::IsEnabled() && !IFileManager::Get().FileExists(*FAuditPackStore::GetPackPath()))
+	{
+		PendingFutures.Add(FAuditThreadPool::Get().Launch([Token = CancellationToken]()
+		{
+			FAuditPackStore::Get().ImportFromFiles(TArray<FString>(), /*bOverwrite=*/ false, &Token.Get());
+		}));
+	}
+
 	// Schedule the stale-check state machine
 	StaleCheckPhase = EStaleCheckPhase::WaitingForRegistry;
 	StaleCheckTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
 		FTickerDelegate::CreateUObject(this, &UBlueprintAuditSubsystem::OnStaleCheckTick));
 
-	FAuditFileUtils::WriteAuditManifest();
+	// Write the manifest off the game thread; it parses and rewrites the per-asset index.
+	// Audits from before the index existed are picked up from the .md tree.
+	PendingFutures.Add(FAuditThreadPool::Get().Launch([Token = CancellationToken]()
+	{
+		if (FAuditIndex::Get().NeedsRebuild())
+		{
+			FAuditIndex::Get().RecordFromFiles(TArray<FString>(), &Token.Get());
+		}
+		FAuditFileUtils::WriteAuditManifest();
+	}));
+	ManifestFlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UBlueprintAuditSubsystem::OnManifestFlushTick), ManifestFlushInterval);
 
 	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Subsystem initialized, watching for Blueprint saves."));
 }
@@ -60,9 +121,35 @@ void UBlueprintAuditSubsystem::Deinitialize()
 		FTSTicker::GetCoreTicker().RemoveTicker(StaleCheckTickerHandle);
 		StaleCheckTickerHandle.Reset();
 	}
+	if (DeferredSaveTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DeferredSaveTickerHandle);
+		DeferredSaveTickerHandle.Reset();
+	}
+	if (ManifestFlushTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ManifestFlushTickerHandle);
+		ManifestFlushTickerHandle.Reset();
+	}
+	if (AuditMoveTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AuditMoveTickerHandle);
+		AuditMoveTickerHandle.Reset();
+	}
+
+	// Moves still queued run here, inline: they are cheap file operations. Renamed
+	// assets that need a re-audit join the deferred saves, which the resume queue keeps.
+	if (AuditMoveFuture.IsValid() && AuditMoveFuture.WaitFor(FTimespan::FromSeconds(ShutdownWaitSeconds)))
+	{
+		DeferredSavedPackages.Append(AuditMoveFuture.Get());
+	}
+	DeferredSavedPackages.Append(RunAuditMoves(PendingAuditMoves));
+	PendingAuditMoves.Reset();
 
 	// 2. Remove event delegates (prevents new OnPackageSaved calls)
 	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+	FEditorDelegates::BeginPIE.RemoveAll(this);
+	FEditorDelegates::EndPIE.RemoveAll(this);
 
 	if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
 	{
@@ -71,24 +158,37 @@ void UBlueprintAuditSubsystem::Deinitialize()
 		AssetRegistry.OnAssetRenamed().RemoveAll(this);
 	}
 
-	// 3. Wait on all background futures with a 5-second total timeout
+	// 3. Stop an offloaded re-audit; the next launch's stale check picks up what it didn't finish
+	if (OffloadProc.IsValid())
+	{
+		if (FPlatformProcess::IsProcRunning(OffloadProc))
+		{
+			FPlatformProcess::TerminateProc(OffloadProc, /*KillTree=*/ true);
+		}
+		FPlatformProcess::CloseProc(OffloadProc);
+	}
+	if (OffloadNotification.IsValid())
+	{
+		OffloadNotification->ExpireAndFadeout();
+		OffloadNotification.Reset();
+	}
+
+	// 4. Cancel background work. Queued tasks return without doing anything, so the
+	// wait only covers files that are mid-write.
+	CancellationToken->Cancel();
+
 	const double WaitStart = FPlatformTime::Seconds();
-	constexpr double TimeoutSec = 5.0;
 
 	if (Phase2Future.IsValid())
 	{
-		const double Remaining = TimeoutSec - (FPlatformTime::Seconds() - WaitStart);
-		if (Remaining > 0)
-		{
-			Phase2Future.WaitFor(FTimespan::FromSeconds(Remaining));
-		}
+		Phase2Future.WaitFor(FTimespan::FromSeconds(ShutdownWaitSeconds));
 	}
 
 	for (TFuture<void>& F : PendingFutures)
 	{
 		if (F.IsValid())
 		{
-			const double Remaining = TimeoutSec - (FPlatformTime::Seconds() - WaitStart);
+			const double Remaining = ShutdownWaitSeconds - (FPlatformTime::Seconds() - WaitStart);
 			if (Remaining > 0)
 			{
 				F.WaitFor(FTimespan::FromSeconds(Remaining));
@@ -97,11 +197,26 @@ void UBlueprintAuditSubsystem::Deinitialize()
 	}
 
 	const double WaitElapsed = FPlatformTime::Seconds() - WaitStart;
-	if (WaitElapsed >= TimeoutSec)
+	if (WaitElapsed >= ShutdownWaitSeconds)
 	{
 		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Shutdown timed out after %.1fs waiting for background tasks"), WaitElapsed);
 	}
 
+	// 5. Persist whatever didn't finish so the next session starts with it
+	SaveResumeQueue();
+	ActiveBlueprintGather.Reset();
+
+	// Bounded like the pool wait: a flush can sit on another process's manifest lock.
+	// One still running writes the snapshot it took; the final flush is skipped.
+	if (ManifestFlushFuture.IsValid() && !ManifestFlushFuture.WaitFor(FTimespan::FromSeconds(ShutdownWaitSeconds)))
+	{
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Shutdown timed out waiting for the audit manifest flush"));
+	}
+	else
+	{
+		FAuditIndex::Get().Flush();
+	}
+
 	PendingFutures.Empty();
 
 	UE_LOG(LogFathomUELink, Log, TEXT("Fathom: Subsystem deinitialized."));
@@ -127,6 +242,18 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 		return;
 	}
 
+	// Keep gather work out of playtests and profiling captures; re-audit once the pause ends
+	if (IsAuditPaused())
+	{
+		DeferredSavedPackages.Add(Package->GetName());
+		if (!DeferredSaveTickerHandle.IsValid())
+		{
+			DeferredSaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateUObject(this, &UBlueprintAuditSubsystem::OnDeferredSaveTick), DeferredSavePollInterval);
+		}
+		return;
+	}
+
 	// Walk all objects in the saved package, looking for auditable assets
 	ForEachObjectWithPackage(Package, [this](UObject* Object)
 	{
@@ -136,8 +263,8 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 			FControlRigAuditData Data = FBlueprintAuditor::GatherControlRigData(CRBP);
 
 			{
-				FScopeLock Lock(&InFlightLock);
-				if (InFlightPackages.Contains(Data.PackageName))
+				FScopeLock Lock(&InFlight->Lock);
+				if (InFlight->Packages.Contains(Data.PackageName))
 				{
 					return true;
 				}
@@ -157,8 +284,8 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 			FBlueprintAuditData Data = FBlueprintAuditor::GatherBlueprintData(BP);
 
 			{
-				FScopeLock Lock(&InFlightLock);
-				if (InFlightPackages.Contains(Data.PackageName))
+				FScopeLock Lock(&InFlight->Lock);
+				if (InFlight->Packages.Contains(Data.PackageName))
 				{
 					UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: %s already in-flight, skipping"), *Data.PackageName);
 					return true;
@@ -170,41 +297,38 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 		}
 		else if (const UDataTable* DT = Cast<UDataTable>(Object))
 		{
-			FDataTableAuditData Data = FBlueprintAuditor::GatherDataTableData(DT);
-
+			// Checked before building the task: a worker-gather task roots the table
 			{
-				FScopeLock Lock(&InFlightLock);
-				if (InFlightPackages.Contains(Data.PackageName))
+				FScopeLock Lock(&InFlight->Lock);
+				if (InFlight->Packages.Contains(DT->GetOutermost()->GetName()))
 				{
 					return true;
 				}
 			}
 
-			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Dispatching async audit for saved DataTable %s"), *Data.Name);
-			DispatchBackgroundWrite(MoveTemp(Data));
+			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Dispatching async audit for saved DataTable %s"), *DT->GetName());
+			DispatchBackgroundWriteTask(FAuditAssetUtils::MakeGatherTask(DT));
 		}
 		else if (const UUserDefinedStruct* UDS = Cast<UUserDefinedStruct>(Object))
 		{
-			FUserDefinedStructAuditData Data = FBlueprintAuditor::GatherUserDefinedStructData(UDS);
-
 			{
-				FScopeLock Lock(&InFlightLock);
-				if (InFlightPackages.Contains(Data.PackageName))
+				FScopeLock Lock(&InFlight->Lock);
+				if (InFlight->Packages.Contains(UDS->GetOutermost()->GetName()))
 				{
 					return true;
 				}
 			}
 
-			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Dispatching async audit for saved UserDefinedStruct %s"), *Data.Name);
-			DispatchBackgroundWrite(MoveTemp(Data));
+			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Dispatching async audit for saved UserDefinedStruct %s"), *UDS->GetName());
+			DispatchBackgroundWriteTask(FAuditAssetUtils::MakeGatherTask(UDS));
 		}
 		else if (const UBehaviorTree* BT = Cast<UBehaviorTree>(Object))
 		{
 			FBehaviorTreeAuditData Data = FBehaviorTreeAuditor::GatherData(BT);
 
 			{
-				FScopeLock Lock(&InFlightLock);
-				if (InFlightPackages.Contains(Data.PackageName))
+				FScopeLock Lock(&InFlight->Lock);
+				if (InFlight->Packages.Contains(Data.PackageName))
 				{
 					return true;
 				}
@@ -218,8 +342,8 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 			FMaterialAuditData Data = FMaterialAuditor::GatherData(Mat);
 
 			{
-				FScopeLock Lock(&InFlightLock);
-				if (InFlightPackages.Contains(Data.PackageName))
+				FScopeLock Lock(&InFlight->Lock);
+				if (InFlight->Packages.Contains(Data.PackageName))
 				{
 					return true;
 				}
@@ -240,8 +364,8 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 					if (Task.IsSet())
 					{
 						{
-							FScopeLock Lock(&InFlightLock);
-							if (InFlightPackages.Contains(Task->PackageName))
+							FScopeLock Lock(&InFlight->Lock);
+							if (InFlight->Packages.Contains(Task->PackageName))
 							{
 								bHandledByExtension = true;
 								break;
@@ -265,8 +389,8 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 					FDataAssetAuditData Data = FBlueprintAuditor::GatherDataAssetData(DA);
 
 					{
-						FScopeLock Lock(&InFlightLock);
-						if (InFlightPackages.Contains(Data.PackageName))
+						FScopeLock Lock(&InFlight->Lock);
+						if (InFlight->Packages.Contains(Data.PackageName))
 						{
 							return true;
 						}
@@ -341,269 +465,352 @@ void UBlueprintAuditSubsystem::OnAssetRenamed(const FAssetData& AssetData, const
 		}
 	}
 
-	if (bHandled)
+	if (!bHandled)
+	{
+		return;
+	}
+
+	const FString NewPackageName = AssetData.PackageName.ToString();
+	if (!FAuditFileUtils::IsAuditablePackage(NewPackageName))
 	{
 		FBlueprintAuditor::DeleteAuditFile(FBlueprintAuditor::GetAuditOutputPath(OldPackageName));
+		return;
+	}
+
+	// Move the audit instead of re-auditing. Folder moves fire one event per asset,
+	// so collect them and hand the whole batch to one background task next tick.
+	FAuditMove& Move = PendingAuditMoves.AddDefaulted_GetRef();
+	Move.OldPackageName = OldPackageName;
+	Move.NewPackageName = NewPackageName;
+	Move.NewObjectPath = AssetData.GetObjectPathString();
+
+	if (!AuditMoveTickerHandle.IsValid())
+	{
+		AuditMoveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UBlueprintAuditSubsystem::OnAuditMoveTick));
 	}
 }
 
-bool UBlueprintAuditSubsystem::OnStaleCheckTick(float DeltaTime)
+bool UBlueprintAuditSubsystem::OnManifestFlushTick(float DeltaTime)
 {
-	switch (StaleCheckPhase)
+	if (FAuditIndex::Get().IsDirty() && !(ManifestFlushFuture.IsValid() && !ManifestFlushFuture.IsReady()))
 	{
-	case EStaleCheckPhase::WaitingForRegistry:
+		ManifestFlushFuture = FAuditThreadPool::Get().Launch([]()
+		{
+			FAuditIndex::Get().Flush();
+		});
+	}
+	return true;
+}
+
+bool UBlueprintAuditSubsystem::OnAuditMoveTick(float DeltaTime)
+{
+	if (AuditMoveFuture.IsValid())
 	{
-		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-		if (AssetRegistry.IsLoadingAssets())
+		if (!AuditMoveFuture.IsReady())
 		{
-			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Asset registry still loading, deferring stale check..."));
-			return true; // keep ticking
+			return true; // one batch at a time; later renames wait in PendingAuditMoves
 		}
-
-		StaleCheckPhase = EStaleCheckPhase::BuildingList;
-		return true;
+		QueueReAudits(AuditMoveFuture.Get());
+		AuditMoveFuture.Reset();
 	}
 
-	case EStaleCheckPhase::BuildingList:
+	if (PendingAuditMoves.IsEmpty())
 	{
-		StaleCheckStartTime = FPlatformTime::Seconds();
+		AuditMoveTickerHandle.Reset();
+		return false; // unregister ticker
+	}
 
-		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-		StaleCheckEntries.Reset();
+	AuditMoveFuture = FAuditThreadPool::Get().Launch([Moves = MoveTemp(PendingAuditMoves)]()
+	{
+		return RunAuditMoves(Moves);
+	});
+	PendingAuditMoves.Reset();
+	return true; // poll for the assets that need a re-audit
+}
 
-		// Blueprints
+TArray<FString> UBlueprintAuditSubsystem::RunAuditMoves(const TArray<FAuditMove>& Moves)
+{
+	int32 Moved = 0;
+	TArray<FString> NeedsReAudit;
+	for (const FAuditMove& Move : Moves)
+	{
+		switch (FAuditFileUtils::MoveAuditFile(Move.OldPackageName, Move.NewPackageName, Move.NewObjectPath))
 		{
-			TArray<FAssetData> AllBlueprints;
-			AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), AllBlueprints, true);
+		case EAuditMoveResult::Moved:
+			++Moved;
+			break;
+		case EAuditMoveResult::NeedsReAudit:
+			NeedsReAudit.Add(Move.NewPackageName);
+			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: %s references its old path, queued for re-audit"), *Move.NewPackageName);
+			break;
+		case EAuditMoveResult::Failed:
+			NeedsReAudit.Add(Move.NewPackageName);
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Could not move the audit of %s, queued for re-audit"), *Move.NewPackageName);
+			break;
+		default:
+			break;
+		}
+	}
 
-			for (const FAssetData& Asset : AllBlueprints)
-			{
-				const FString PackageName = Asset.PackageName.ToString();
-				if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-				{
-					continue;
-				}
+	if (Moves.Num() > 0)
+	{
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Moved %d of %d audit file(s) for renamed assets, %d need re-audit"),
+			Moved, Moves.Num(), NeedsReAudit.Num());
+	}
+	return NeedsReAudit;
+}
 
-				if (!FBlueprintAuditor::IsSupportedBlueprintClass(Asset.AssetClassPath))
-				{
-					UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Skipping unsupported Blueprint class %s (%s)"),
-						*PackageName, *Asset.AssetClassPath.ToString());
-					continue;
-				}
+void UBlueprintAuditSubsystem::QueueReAudits(const TArray<FString>& PackageNames)
+{
+	if (PackageNames.IsEmpty())
+	{
+		return;
+	}
 
-				FStaleCheckEntry Entry;
-				Entry.PackageName = PackageName;
-				Entry.SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
-				Entry.AuditPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-				Entry.AssetType = EAuditAssetType::Blueprint;
-				StaleCheckEntries.Add(MoveTemp(Entry));
-			}
-		}
+	// Same path as a save made during a pause: re-audited now, or once the pause ends
+	DeferredSavedPackages.Append(PackageNames);
+	if (!IsAuditPaused())
+	{
+		FlushDeferredSaves();
+	}
+	else if (!DeferredSaveTickerHandle.IsValid())
+	{
+		DeferredSaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UBlueprintAuditSubsystem::OnDeferredSaveTick), DeferredSavePollInterval);
+	}
+}
+
+void UBlueprintAuditSubsystem::LoadResumeQueue()
+{
+	const FString QueuePath = GetResumeQueuePath();
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *QueuePath))
+	{
+		return;
+	}
+	IFileManager::Get().Delete(*QueuePath);
 
-		// DataTables
+	for (const FString& Line : Lines)
+	{
+		if (!Line.IsEmpty())
 		{
-			TArray<FAssetData> AllDataTables;
-			AssetRegistry.GetAssetsByClass(UDataTable::StaticClass()->GetClassPathName(), AllDataTables, false);
+			ResumeQueuePackages.Add(Line);
+		}
+	}
 
-			for (const FAssetData& Asset : AllDataTables)
-			{
-				const FString PackageName = Asset.PackageName.ToString();
-				if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-				{
-					continue;
-				}
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Resuming %d audit(s) left unfinished by the previous session"), ResumeQueuePackages.Num());
+}
 
-				FStaleCheckEntry Entry;
-				Entry.PackageName = PackageName;
-				Entry.SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
-				Entry.AuditPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-				Entry.AssetType = EAuditAssetType::DataTable;
-				StaleCheckEntries.Add(MoveTemp(Entry));
-			}
-		}
+void UBlueprintAuditSubsystem::SaveResumeQueue()
+{
+	TSet<FString> Unfinished;
+	{
+		FScopeLock Lock(&InFlight->Lock);
+		Unfinished.Append(InFlight->Packages);
+	}
+	Unfinished.Append(DeferredSavedPackages);
+	if (ActiveBlueprintGather.IsValid())
+	{
+		Unfinished.Add(ActiveBlueprintGather->GetPackageName());
+	}
 
-		// DataAssets
+	const bool bStaleListPending = StaleCheckPhase == EStaleCheckPhase::WritingStubs
+		|| StaleCheckPhase == EStaleCheckPhase::ProcessingStale
+		|| StaleCheckPhase == EStaleCheckPhase::ProcessingStaleWithProgress;
+	if (bStaleListPending)
+	{
+		for (int32 i = StaleProcessIndex; i < StaleEntries.Num(); ++i)
 		{
-			TArray<FAssetData> AllDataAssets;
-			AssetRegistry.GetAssetsByClass(UDataAsset::StaticClass()->GetClassPathName(), AllDataAssets, true);
+			Unfinished.Add(StaleEntries[i].PackageName);
+		}
+	}
 
-			const auto& Extensions = FAuditExtensionRegistry::Get().GetExtensions();
+	// Not consumed yet (shut down before the stale check got to it): carry it over
+	Unfinished.Append(ResumeQueuePackages);
 
-			for (const FAssetData& Asset : AllDataAssets)
-			{
-				const FString PackageName = Asset.PackageName.ToString();
-				if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-				{
-					continue;
-				}
+	if (Unfinished.Num() == 0)
+	{
+		return;
+	}
 
-				// Skip assets handled by extension auditors (e.g. StateTree inherits UDataAsset)
-				bool bHandledByExtension = false;
-				for (const auto& Ext : Extensions)
-				{
-					if (Ext.IsHandledAsset && Ext.IsHandledAsset(Asset))
-					{
-						bHandledByExtension = true;
-						break;
-					}
-				}
-				if (bHandledByExtension)
-				{
-					continue;
-				}
+	if (FFileHelper::SaveStringArrayToFile(Unfinished.Array(), *GetResumeQueuePath()))
+	{
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Saved %d unfinished audit(s) to the resume queue"), Unfinished.Num());
+	}
+}
 
-				FStaleCheckEntry Entry;
-				Entry.PackageName = PackageName;
-				Entry.SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
-				Entry.AuditPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-				Entry.AssetType = EAuditAssetType::DataAsset;
-				StaleCheckEntries.Add(MoveTemp(Entry));
-			}
-		}
+bool UBlueprintAuditSubsystem::IsAuditPaused() const
+{
+	return bPIEActive || FTraceAuxiliary::IsConnected();
+}
 
-		// UserDefinedStructs
-		{
-			TArray<FAssetData> AllStructs;
-			AssetRegistry.GetAssetsByClass(UUserDefinedStruct::StaticClass()->GetClassPathName(), AllStructs, false);
+TArray<FString> UBlueprintAuditSubsystem::GetPauseReasons() const
+{
+	TArray<FString> Reasons;
+	if (bPIEActive)
+	{
+		Reasons.Add(TEXT("pie"));
+	}
+	if (FTraceAuxiliary::IsConnected())
+	{
+		Reasons.Add(TEXT("trace"));
+	}
+	return Reasons;
+}
 
-			for (const FAssetData& Asset : AllStructs)
-			{
-				const FString PackageName = Asset.PackageName.ToString();
-				if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-				{
-					continue;
-				}
+void UBlueprintAuditSubsystem::OnBeginPIE(const bool bIsSimulating)
+{
+	bPIEActive = true;
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Play-In-Editor started, pausing audit work"));
+}
 
-				FStaleCheckEntry Entry;
-				Entry.PackageName = PackageName;
-				Entry.SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
-				Entry.AuditPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-				Entry.AssetType = EAuditAssetType::UserDefinedStruct;
-				StaleCheckEntries.Add(MoveTemp(Entry));
-			}
-		}
+void UBlueprintAuditSubsystem::OnEndPIE(const bool bIsSimulating)
+{
+	bPIEActive = false;
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Play-In-Editor ended, resuming audit work"));
+}
 
-		// Materials
-		{
-			TArray<FAssetData> AllMaterials;
-			AssetRegistry.GetAssetsByClass(UMaterial::StaticClass()->GetClassPathName(), AllMaterials, false);
+bool UBlueprintAuditSubsystem::OnDeferredSaveTick(float DeltaTime)
+{
+	if (IsAuditPaused())
+	{
+		return true; // keep polling
+	}
 
-			for (const FAssetData& Asset : AllMaterials)
-			{
-				const FString PackageName = Asset.PackageName.ToString();
-				if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-				{
-					continue;
-				}
+	FlushDeferredSaves();
+	DeferredSaveTickerHandle.Reset();
+	return false; // unregister ticker
+}
 
-				FStaleCheckEntry Entry;
-				Entry.PackageName = PackageName;
-				Entry.SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
-				Entry.AuditPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-				Entry.AssetType = EAuditAssetType::Material;
-				StaleCheckEntries.Add(MoveTemp(Entry));
-			}
-		}
+void UBlueprintAuditSubsystem::FlushDeferredSaves()
+{
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Re-auditing %d deferred package(s)"), DeferredSavedPackages.Num());
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	for (const FString& PackageName : DeferredSavedPackages)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(FName(*PackageName), Assets);
 
-		// Material Instances
+		FStaleCheckEntry Entry;
+		const FAssetData* Auditable = Assets.FindByPredicate([&Entry](const FAssetData& Asset)
+		{
+			return FAuditAssetUtils::TryMakeEntry(Asset, Entry);
+		});
+		if (!Auditable)
 		{
-			TArray<FAssetData> AllMaterialInstances;
-			AssetRegistry.GetAssetsByClass(UMaterialInstanceConstant::StaticClass()->GetClassPathName(), AllMaterialInstances, false);
+			continue; // deleted or no longer auditable since the save
+		}
 
-			for (const FAssetData& Asset : AllMaterialInstances)
+		{
+			FScopeLock Lock(&InFlight->Lock);
+			if (InFlight->Packages.Contains(PackageName))
 			{
-				const FString PackageName = Asset.PackageName.ToString();
-				if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-				{
-					continue;
-				}
-
-				FStaleCheckEntry Entry;
-				Entry.PackageName = PackageName;
-				Entry.SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
-				Entry.AuditPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-				Entry.AssetType = EAuditAssetType::Material;
-				StaleCheckEntries.Add(MoveTemp(Entry));
+				continue;
 			}
 		}
 
-		// BehaviorTrees
+		if (TOptional<FAuditWriteTask> Task = FAuditAssetUtils::LoadAndGather(Entry))
 		{
-			TArray<FAssetData> AllBTs;
-			AssetRegistry.GetAssetsByClass(UBehaviorTree::StaticClass()->GetClassPathName(), AllBTs, false);
-
-			for (const FAssetData& Asset : AllBTs)
-			{
-				const FString PackageName = Asset.PackageName.ToString();
-				if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-				{
-					continue;
-				}
-
-				FStaleCheckEntry Entry;
-				Entry.PackageName = PackageName;
-				Entry.SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
-				Entry.AuditPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-				Entry.AssetType = EAuditAssetType::BehaviorTree;
-				StaleCheckEntries.Add(MoveTemp(Entry));
-			}
+			DispatchBackgroundWriteTask(MoveTemp(*Task));
 		}
+	}
+	DeferredSavedPackages.Empty();
+}
 
-		// Extension auditors (e.g. StateTree)
-		for (const auto& Ext : FAuditExtensionRegistry::Get().GetExtensions())
+bool UBlueprintAuditSubsystem::OnStaleCheckTick(float DeltaTime)
+{
+	// Suspended during PIE and trace capture; every phase resumes where it left off
+	if (IsAuditPaused() && StaleCheckPhase != EStaleCheckPhase::Done)
+	{
+		return true;
+	}
+
+	switch (StaleCheckPhase)
+	{
+	case EStaleCheckPhase::WaitingForRegistry:
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		if (AssetRegistry.IsLoadingAssets())
 		{
-			if (Ext.BuildStaleCheckList)
-			{
-				Ext.BuildStaleCheckList(AssetRegistry, StaleCheckEntries);
-			}
+			UE_LOG(LogFathomUELink, Verbose, TEXT("Fathom: Asset registry still loading, deferring stale check..."));
+			return true; // keep ticking
 		}
 
+		StaleCheckPhase = EStaleCheckPhase::BuildingList;
+		return true;
+	}
+
+	case EStaleCheckPhase::BuildingList:
+	{
+		StaleCheckStartTime = FPlatformTime::Seconds();
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		StaleCheckEntries.Reset();
+
+		FAuditAssetUtils::CollectEntries(AssetRegistry, StaleCheckEntries);
+
 		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Stale check Phase 1 complete: %d assets to check"), StaleCheckEntries.Num());
 
 		// Dispatch Phase 2 to a background thread: hash comparison
 		TArray<FStaleCheckEntry> EntriesCopy = StaleCheckEntries;
-		Phase2Future = Async(EAsyncExecution::ThreadPool, [Entries = MoveTemp(EntriesCopy)]() -> TArray<FStaleCheckEntry>
+		Phase2Future = FAuditThreadPool::Get().Launch([Entries = MoveTemp(EntriesCopy), Token = CancellationToken]() -> FPhase2Result
 		{
-			TArray<FStaleCheckEntry> StaleResults;
+			FPhase2Result Result;
+			TArray<FStaleCheckEntry> ToMigrate;
 
 			for (const FStaleCheckEntry& Entry : Entries)
 			{
-				if (Entry.SourcePath.IsEmpty())
+				if (Token->IsCanceled())
 				{
-					continue;
+					return Result; // shutting down; the next session hashes again
 				}
-
-				const FString CurrentHash = FBlueprintAuditor::ComputeFileHash(Entry.SourcePath);
-				if (CurrentHash.IsEmpty())
+				switch (FAuditAssetUtils::GetAuditStaleness(Entry))
 				{
-					continue;
+				case EAuditStaleness::Stale:          Result.Stale.Add(Entry); break;
+				case EAuditStaleness::NeedsMigration: ToMigrate.Add(Entry); break;
+				default: break;
 				}
+			}
 
-				FString StoredHash;
-				FString FileContent;
-				if (FFileHelper::LoadFileToString(FileContent, *Entry.AuditPath))
+			// Format-only gaps are rewritten as text; one that no longer migrates is re-audited
+			for (const FStaleCheckEntry& Entry : ToMigrate)
+			{
+				if (Token->IsCanceled())
 				{
-					const FString HashPrefix = TEXT("Hash: ");
-					int32 Pos = FileContent.Find(HashPrefix);
-					if (Pos != INDEX_NONE)
-					{
-						Pos += HashPrefix.Len();
-						int32 EndPos = FileContent.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
-						if (EndPos == INDEX_NONE)
-						{
-							EndPos = FileContent.Len();
-						}
-						StoredHash = FileContent.Mid(Pos, EndPos - Pos).TrimEnd();
-					}
+					return Result;
 				}
-
-				if (CurrentHash != StoredHash)
+				if (FAuditAssetUtils::MigrateAudit(Entry))
+				{
+					++Result.Migrated;
+				}
+				else
 				{
-					StaleResults.Add(Entry);
+					Result.Stale.Add(Entry);
 				}
 			}
 
-			return StaleResults;
+			// Stale here may still be audited elsewhere: copy the shared cache's audit instead of loading
+			if (FAuditCache::IsEnabled())
+			{
+				Result.Stale.RemoveAll([&Result, &Token](const FStaleCheckEntry& Entry)
+				{
+					if (Token->IsCanceled())
+					{
+						return false;
+					}
+					if (FAuditCache::Get().TryRestore(Entry))
+					{
+						++Result.CacheHits;
+						return true;
+					}
+					++Result.CacheMisses;
+					return false;
+				});
+			}
+
+			return Result;
 		});
 
 		StaleCheckPhase = EStaleCheckPhase::BackgroundHash;
@@ -617,41 +824,164 @@ bool UBlueprintAuditSubsystem::OnStaleCheckTick(float DeltaTime)
 			return true; // keep polling
 		}
 
-		StaleEntries = Phase2Future.Get();
+		FPhase2Result Result = Phase2Future.Get();
+		StaleEntries = MoveTemp(Result.Stale);
+		StaleMigratedCount = Result.Migrated;
+		StaleRestoredCount = Result.CacheHits;
 		StaleProcessIndex = 0;
 		StaleReAuditedCount = 0;
 		StaleFailedCount = 0;
 		AssetsSinceGC = 0;
 		TickFrameCounter = 0;
 
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Stale check Phase 2 complete: %d stale asset(s) to re-audit"), StaleEntries.Num());
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Stale check Phase 2 complete: %d stale asset(s) to re-audit, %d migrated"),
+			StaleEntries.Num(), StaleMigratedCount);
+		if (FAuditCache::IsEnabled())
+		{
+			UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Shared audit cache: %d restored, %d not found"),
+				Result.CacheHits, Result.CacheMisses);
+		}
 
-		if (StaleEntries.Num() == 0)
+		// Work left unfinished by the previous session goes first. Its packages that are
+		// still stale are now in StaleEntries (and saved from there on shutdown), so the
+		// queue is consumed here whether or not anything is stale.
+		StalePriority.Reset();
+		for (const FStaleCheckEntry& Entry : StaleEntries)
+		{
+			if (ResumeQueuePackages.Contains(Entry.PackageName))
+			{
+				StalePriority.Add(Entry.PackageName, MAX_int32);
+			}
+		}
+		ResumeQueuePackages.Empty();
+
+		if (StaleEntries.Num() == 0)
 		{
 			StaleCheckPhase = EStaleCheckPhase::Done;
 			return true;
 		}
 
-		// Branch on size: above threshold gets a visible cancelable dialog;
-		// below threshold uses invisible per-frame pacing.
-		StaleCheckPhase = (StaleEntries.Num() >= SlowTaskThreshold)
-			? EStaleCheckPhase::ProcessingStaleWithProgress
-			: EStaleCheckPhase::ProcessingStale;
+		StubProcessIndex = 0;
+		StaleCheckPhase = EStaleCheckPhase::WritingStubs;
 		return true;
 	}
 
-	case EStaleCheckPhase::ProcessingStale:
+	case EStaleCheckPhase::WritingStubs:
 	{
-		// Pace one entry every Nth tick. LoadObject is the indivisible hitch unit;
-		// spacing keeps each individual frame freeze short and gives the editor
-		// breathing room between hitches.
-		if (++TickFrameCounter < FramesPerStaleEntry)
+		// Registry-only first tier: gather a stub for a chunk of stale entries per
+		// tick and write it for those that have no audit file yet. No LoadObject,
+		// so a first run has something for every asset within seconds instead of
+		// waiting on the full pass.
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		TArray<FAssetStubAuditData> Stubs;
+		const int32 ChunkEnd = FMath::Min(StubProcessIndex + StubsPerTick, StaleEntries.Num());
+		for (; StubProcessIndex < ChunkEnd; ++StubProcessIndex)
+		{
+			const FStaleCheckEntry& Entry = StaleEntries[StubProcessIndex];
+			FAssetStubAuditData Stub;
+			if (FAuditAssetUtils::GatherStub(AssetRegistry, Entry, Stub))
+			{
+				if (!StalePriority.Contains(Entry.PackageName))
+				{
+					StalePriority.Add(Entry.PackageName, Stub.ReferencerCount);
+				}
+				Stubs.Add(MoveTemp(Stub));
+			}
+		}
+
+		if (Stubs.Num() > 0)
+		{
+			CleanupCompletedFutures();
+			PendingFutures.Add(FAuditThreadPool::Get().Launch([Stubs = MoveTemp(Stubs), Token = CancellationToken]()
+			{
+				for (const FAssetStubAuditData& Stub : Stubs)
+				{
+					if (Token->IsCanceled())
+					{
+						return;
+					}
+					FAuditAssetUtils::WriteStubIfMissing(Stub);
+				}
+			}));
+		}
+
+		if (StubProcessIndex < StaleEntries.Num())
 		{
 			return true;
 		}
-		TickFrameCounter = 0;
 
-		ProcessSingleStaleEntry(StaleEntries[StaleProcessIndex]);
+		// Full audits replace stubs by priority: resumed work, then the most-referenced
+		// assets, since those are the ones most likely to be asked about
+		StaleEntries.StableSort([this](const FStaleCheckEntry& A, const FStaleCheckEntry& B)
+		{
+			return StalePriority.FindRef(A.PackageName) > StalePriority.FindRef(B.PackageName);
+		});
+		StalePriority.Empty();
+
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Stale check stub tier complete after %.2fs"),
+			FPlatformTime::Seconds() - StaleCheckStartTime);
+
+		// Branch on size: above threshold gets a background child process (if enabled)
+		// or a visible cancelable dialog; below threshold uses invisible per-frame pacing.
+		if (StaleEntries.Num() < SlowTaskThreshold)
+		{
+			StaleCheckPhase = EStaleCheckPhase::ProcessingStale;
+		}
+		else if (GetDefault<UFathomAuditSettings>()->bOffloadBulkReAudit && LaunchOffloadedReAudit(/*bResume=*/ false))
+		{
+			StaleCheckPhase = EStaleCheckPhase::OffloadedToChildProcess;
+		}
+		else
+		{
+			StaleCheckPhase = EStaleCheckPhase::ProcessingStaleWithProgress;
+		}
+		return true;
+	}
+
+	case EStaleCheckPhase::ProcessingStale:
+	{
+		int32 FramesPerEntry = FramesPerStaleEntry;
+		double GatherBudget = GatherBudgetSeconds;
+		if (!GetStalePacing(FramesPerEntry, GatherBudget))
+		{
+			return true; // paused while the user is interacting
+		}
+
+		// A Blueprint gather in progress continues every tick under its time budget
+		if (ActiveBlueprintGather.IsValid())
+		{
+			if (!ActiveBlueprintGather->Step(GatherBudget))
+			{
+				return true;
+			}
+			FinishBlueprintGather();
+		}
+		else
+		{
+			// Pace one entry every Nth tick. LoadObject is the indivisible hitch unit;
+			// spacing keeps each individual frame freeze short and gives the editor
+			// breathing room between hitches.
+			if (++TickFrameCounter < FramesPerEntry)
+			{
+				return true;
+			}
+			TickFrameCounter = 0;
+
+			const FStaleCheckEntry& Entry = StaleEntries[StaleProcessIndex];
+			if (BeginBlueprintGather(Entry))
+			{
+				if (!ActiveBlueprintGather->Step(GatherBudget))
+				{
+					return true; // entry stays current until its gather finishes
+				}
+				FinishBlueprintGather();
+			}
+			else
+			{
+				ProcessSingleStaleEntry(Entry);
+			}
+		}
 		++StaleProcessIndex;
 
 		if (++AssetsSinceGC >= GCInterval)
@@ -673,6 +1003,12 @@ bool UBlueprintAuditSubsystem::OnStaleCheckTick(float DeltaTime)
 
 	case EStaleCheckPhase::ProcessingStaleWithProgress:
 	{
+		// The dialog is modal; with idle-aware scheduling, don't pop it up mid-interaction
+		if (GetDefault<UFathomAuditSettings>()->bIdleAwareScheduling && !IsUserIdle())
+		{
+			return true;
+		}
+
 		// Run synchronously inside an FScopedSlowTask. This blocks the ticker for
 		// the duration of the bulk re-audit, but the slow task pumps Slate during
 		// EnterProgressFrame so the editor remains responsive (dialog redraws,
@@ -683,11 +1019,26 @@ bool UBlueprintAuditSubsystem::OnStaleCheckTick(float DeltaTime)
 		return true;
 	}
 
+	case EStaleCheckPhase::OffloadedToChildProcess:
+	{
+		// The child writes audit files straight into the audit directory; the
+		// editor only has to watch it and report the outcome
+		if (!PollOffloadedReAudit())
+		{
+			StaleCheckPhase = EStaleCheckPhase::Done;
+		}
+		return true;
+	}
+
 	case EStaleCheckPhase::Done:
 	{
 		const double Elapsed = FPlatformTime::Seconds() - StaleCheckStartTime;
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Stale check complete: %d scanned, %d re-audited, %d failed in %.2fs"),
-			StaleCheckEntries.Num(), StaleReAuditedCount, StaleFailedCount, Elapsed);
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Stale check complete: %d scanned, %d migrated, %d restored, %d re-audited, %d failed in %.2fs"),
+			StaleCheckEntries.Num(), StaleMigratedCount, StaleRestoredCount, StaleReAuditedCount, StaleFailedCount, Elapsed);
+
+		const FAuditWriteStats WriteStats = FAuditFileUtils::GetWriteStats();
+		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: %lld audit file(s) written (%lld migrated and %lld copied from the shared cache without a load), %lld unchanged and skipped, %lld failed this session"),
+			WriteStats.Written, WriteStats.Migrated, WriteStats.Cached, WriteStats.Unchanged, WriteStats.Failed);
 
 		SweepOrphanedAuditFiles();
 
@@ -704,128 +1055,89 @@ bool UBlueprintAuditSubsystem::OnStaleCheckTick(float DeltaTime)
 	}
 }
 
-void UBlueprintAuditSubsystem::ProcessSingleStaleEntry(const FStaleCheckEntry& StaleEntry)
+bool UBlueprintAuditSubsystem::IsUserIdle() const
 {
-	const FString& PackageName = StaleEntry.PackageName;
-	const FString AssetPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+	if (!FSlateApplication::IsInitialized())
+	{
+		return true;
+	}
 
-	switch (StaleEntry.AssetType)
+	const FSlateApplication& Slate = FSlateApplication::Get();
+	if (!Slate.IsActive())
 	{
-	case EAuditAssetType::Blueprint:
+		return true; // editor is in the background
+	}
+
+	const double SinceLastInput = Slate.GetCurrentTime() - Slate.GetLastUserInteractionTime();
+	return SinceLastInput >= GetDefault<UFathomAuditSettings>()->IdleThresholdSeconds;
+}
+
+bool UBlueprintAuditSubsystem::GetStalePacing(int32& OutFramesPerEntry, double& OutGatherBudgetSeconds) const
+{
+	const UFathomAuditSettings* Settings = GetDefault<UFathomAuditSettings>();
+	if (!Settings->bIdleAwareScheduling)
 	{
-		UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *AssetPath);
-		if (!BP)
-		{
-			++StaleFailedCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load Blueprint %s for re-audit"), *PackageName);
-			return;
-		}
-#if FATHOM_HAS_CONTROLRIG_BLUEPRINT
-		if (const UControlRigBlueprint* CRBP = Cast<UControlRigBlueprint>(BP))
-		{
-			FControlRigAuditData Data = FBlueprintAuditor::GatherControlRigData(CRBP);
-			DispatchBackgroundWrite(MoveTemp(Data));
-		}
-		else
-#endif
-		{
-			FBlueprintAuditData Data = FBlueprintAuditor::GatherBlueprintData(BP);
-			DispatchBackgroundWrite(MoveTemp(Data));
-		}
-		++StaleReAuditedCount;
-		return;
+		return true;
 	}
-	case EAuditAssetType::DataTable:
+
+	if (IsUserIdle())
 	{
-		UDataTable* DT = LoadObject<UDataTable>(nullptr, *AssetPath);
-		if (!DT)
-		{
-			++StaleFailedCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load DataTable %s for re-audit"), *PackageName);
-			return;
-		}
-		FDataTableAuditData Data = FBlueprintAuditor::GatherDataTableData(DT);
-		DispatchBackgroundWrite(MoveTemp(Data));
-		++StaleReAuditedCount;
-		return;
+		OutFramesPerEntry = IdleFramesPerStaleEntry;
+		OutGatherBudgetSeconds = IdleGatherBudgetSeconds;
+		return true;
 	}
-	case EAuditAssetType::DataAsset:
+
+	if (Settings->bPauseWhileActive)
 	{
-		UDataAsset* DA = LoadObject<UDataAsset>(nullptr, *AssetPath);
-		if (!DA)
-		{
-			++StaleFailedCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load DataAsset %s for re-audit"), *PackageName);
-			return;
-		}
-		FDataAssetAuditData Data = FBlueprintAuditor::GatherDataAssetData(DA);
-		DispatchBackgroundWrite(MoveTemp(Data));
-		++StaleReAuditedCount;
-		return;
+		return false;
 	}
-	case EAuditAssetType::UserDefinedStruct:
+
+	OutFramesPerEntry = TrickleFramesPerStaleEntry;
+	return true;
+}
+
+bool UBlueprintAuditSubsystem::BeginBlueprintGather(const FStaleCheckEntry& Entry)
+{
+	if (Entry.AssetType != EAuditAssetType::Blueprint)
 	{
-		UUserDefinedStruct* UDS = LoadObject<UUserDefinedStruct>(nullptr, *AssetPath);
-		if (!UDS)
-		{
-			++StaleFailedCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load UserDefinedStruct %s for re-audit"), *PackageName);
-			return;
-		}
-		FUserDefinedStructAuditData Data = FBlueprintAuditor::GatherUserDefinedStructData(UDS);
-		DispatchBackgroundWrite(MoveTemp(Data));
-		++StaleReAuditedCount;
-		return;
+		return false;
 	}
-	case EAuditAssetType::Material:
+
+	const FString AssetPath = Entry.PackageName + TEXT(".") + FPackageName::GetShortName(Entry.PackageName);
+	UBlueprint* BP = LoadObject<UBlueprint>(nullptr, *AssetPath);
+	if (!BP)
 	{
-		UMaterialInterface* Mat = LoadObject<UMaterialInterface>(nullptr, *AssetPath);
-		if (!Mat)
-		{
-			++StaleFailedCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load Material %s for re-audit"), *PackageName);
-			return;
-		}
-		FMaterialAuditData Data = FMaterialAuditor::GatherData(Mat);
-		DispatchBackgroundWrite(MoveTemp(Data));
-		++StaleReAuditedCount;
-		return;
+		return false; // ProcessSingleStaleEntry reports the load failure
 	}
-	case EAuditAssetType::BehaviorTree:
+#if FATHOM_HAS_CONTROLRIG_BLUEPRINT
+	if (BP->IsA<UControlRigBlueprint>())
 	{
-		UBehaviorTree* BT = LoadObject<UBehaviorTree>(nullptr, *AssetPath);
-		if (!BT)
-		{
-			++StaleFailedCount;
-			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load BehaviorTree %s for re-audit"), *PackageName);
-			return;
-		}
-		FBehaviorTreeAuditData Data = FBehaviorTreeAuditor::GatherData(BT);
-		DispatchBackgroundWrite(MoveTemp(Data));
-		++StaleReAuditedCount;
-		return;
+		return false; // ControlRig gather walks RigVM graphs, not EdGraphs
 	}
-	default:
+#endif
+
+	ActiveBlueprintGather = MakeUnique<FBlueprintGatherTask>(BP);
+	return true;
+}
+
+void UBlueprintAuditSubsystem::FinishBlueprintGather()
+{
+	DispatchBackgroundWrite(ActiveBlueprintGather->TakeData());
+	ActiveBlueprintGather.Reset();
+	++StaleReAuditedCount;
+}
+
+void UBlueprintAuditSubsystem::ProcessSingleStaleEntry(const FStaleCheckEntry& StaleEntry)
+{
+	TOptional<FAuditWriteTask> Task = FAuditAssetUtils::LoadAndGather(StaleEntry);
+	if (!Task.IsSet())
 	{
-		for (const auto& Ext : FAuditExtensionRegistry::Get().GetExtensions())
-		{
-			if (Ext.ReAuditStaleEntry)
-			{
-				TOptional<FAuditWriteTask> Task = Ext.ReAuditStaleEntry(StaleEntry);
-				if (Task.IsSet())
-				{
-					DispatchBackgroundWriteTask(MoveTemp(*Task));
-					++StaleReAuditedCount;
-					return;
-				}
-			}
-		}
 		++StaleFailedCount;
-		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: No handler for stale asset %s (type %d)"),
-			*PackageName, static_cast<int32>(StaleEntry.AssetType));
 		return;
 	}
-	}
+
+	DispatchBackgroundWriteTask(MoveTemp(*Task));
+	++StaleReAuditedCount;
 }
 
 void UBlueprintAuditSubsystem::RunStaleProcessingWithProgressDialog()
@@ -882,182 +1194,218 @@ void UBlueprintAuditSubsystem::RunStaleProcessingWithProgressDialog()
 	}
 }
 
-void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FBlueprintAuditData&& Data)
+bool UBlueprintAuditSubsystem::LaunchOffloadedReAudit(bool bResume)
 {
-	const FString PackageName = Data.PackageName;
-	const FString OutputPath = Data.OutputPath;
-
-	// Add to in-flight set (under lock)
+	const FString CmdPath = FPlatformProcess::GenerateApplicationPath(TEXT("UnrealEditor-Cmd"), FApp::GetBuildConfiguration());
+	if (!FPaths::FileExists(CmdPath))
 	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: %s not found, re-auditing in the editor instead"), *CmdPath);
+		return false;
 	}
 
-	CleanupCompletedFutures();
-
-	// Capture Data by move, PackageName/OutputPath by copy for the lambda
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedData = MoveTemp(Data), PackageName, OutputPath]()
+	const FString ListPath = GetOffloadListPath();
+	const FString JournalPath = GetOffloadJournalPath();
+	if (!bResume)
+	{
+		FString List;
+		for (const FStaleCheckEntry& Entry : StaleEntries)
 		{
-			const FString Markdown = FBlueprintAuditor::SerializeToMarkdown(MovedData);
-			FBlueprintAuditor::WriteAuditFile(Markdown, OutputPath);
-
-			// Remove from in-flight set
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
-		});
-
-	PendingFutures.Add(MoveTemp(Future));
-}
-
-void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FDataTableAuditData&& Data)
-{
-	const FString PackageName = Data.PackageName;
-	const FString OutputPath = Data.OutputPath;
+			List += Entry.PackageName;
+			List += TEXT("\n");
+		}
+		if (!FFileHelper::SaveStringToFile(List, *ListPath))
+		{
+			UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to write %s, re-auditing in the editor instead"), *ListPath);
+			return false;
+		}
+		OffloadRestarts = 0;
+	}
 
+	// The editor owns the manifest index and packed store; it imports the child's .md output when the child exits
+	const FString Args = FString::Printf(
+		TEXT("\"%s\" -run=BlueprintAudit -ChangedFiles=\"%s\" -Journal=\"%s\"%s -FathomAuditChild -unattended -nopause -nosplash -nullrhi"),
+		*FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()), *ListPath, *JournalPath,
+		bResume ? TEXT(" -Resume") : TEXT(""));
+
+	// Below-normal priority so the child doesn't compete with the editor for CPU
+	OffloadProc = FPlatformProcess::CreateProc(*CmdPath, *Args,
+		/*bLaunchDetached=*/ false, /*bLaunchHidden=*/ true, /*bLaunchReallyHidden=*/ true,
+		nullptr, /*PriorityModifier=*/ -1, nullptr, nullptr);
+	if (!OffloadProc.IsValid())
 	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to launch %s, re-auditing in the editor instead"), *CmdPath);
+		return false;
 	}
 
-	CleanupCompletedFutures();
+	UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Offloaded re-audit of %d stale asset(s) to a background process%s"),
+		StaleEntries.Num(), bResume ? TEXT(" (resume)") : TEXT(""));
 
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedData = MoveTemp(Data), PackageName, OutputPath]()
+	if (!OffloadNotification.IsValid())
+	{
+		FNotificationInfo Info(FText::Format(
+			NSLOCTEXT("Fathom", "OffloadStarting", "Fathom: re-auditing {0} asset(s) in the background"),
+			FText::AsNumber(StaleEntries.Num())));
+		Info.bFireAndForget = false;
+		Info.ExpireDuration = 4.0f;
+		OffloadNotification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (OffloadNotification.IsValid())
 		{
-			const FString Markdown = FBlueprintAuditor::SerializeDataTableToMarkdown(MovedData);
-			FBlueprintAuditor::WriteAuditFile(Markdown, OutputPath);
-
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
-		});
+			OffloadNotification->SetCompletionState(SNotificationItem::CS_Pending);
+		}
+	}
 
-	PendingFutures.Add(MoveTemp(Future));
+	LastOffloadPollTime = FPlatformTime::Seconds();
+	return true;
 }
 
-void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FDataAssetAuditData&& Data)
+bool UBlueprintAuditSubsystem::PollOffloadedReAudit()
 {
-	const FString PackageName = Data.PackageName;
-	const FString OutputPath = Data.OutputPath;
-
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastOffloadPollTime < OffloadPollInterval)
 	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
+		return true;
 	}
+	LastOffloadPollTime = Now;
 
-	CleanupCompletedFutures();
+	const FAuditJournal::FSummary Summary = FAuditJournal::ReadSummary(GetOffloadJournalPath());
+	const int32 Total = Summary.Total > 0 ? Summary.Total : StaleEntries.Num();
 
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedData = MoveTemp(Data), PackageName, OutputPath]()
+	if (FPlatformProcess::IsProcRunning(OffloadProc))
+	{
+		if (OffloadNotification.IsValid())
 		{
-			const FString Markdown = FBlueprintAuditor::SerializeDataAssetToMarkdown(MovedData);
-			FBlueprintAuditor::WriteAuditFile(Markdown, OutputPath);
-
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
-		});
-
-	PendingFutures.Add(MoveTemp(Future));
-}
+			OffloadNotification->SetText(FText::Format(
+				NSLOCTEXT("Fathom", "OffloadProgress", "Fathom: re-auditing in the background ({0}/{1})"),
+				FText::AsNumber(Summary.Completed), FText::AsNumber(Total)));
+		}
+		return true;
+	}
 
-void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FUserDefinedStructAuditData&& Data)
-{
-	const FString PackageName = Data.PackageName;
-	const FString OutputPath = Data.OutputPath;
+	int32 ExitCode = 0;
+	FPlatformProcess::GetProcReturnCode(OffloadProc, &ExitCode);
+	FPlatformProcess::CloseProc(OffloadProc);
 
+	// Died mid-asset: relaunch so the child quarantines that asset and carries on
+	if (!Summary.bFinished && !Summary.InFlightPackage.IsEmpty() && OffloadRestarts < MaxOffloadRestarts)
 	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
+		++OffloadRestarts;
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Background re-audit exited with code %d while auditing %s, resuming (%d/%d)"),
+			ExitCode, *Summary.InFlightPackage, OffloadRestarts, MaxOffloadRestarts);
+		if (LaunchOffloadedReAudit(/*bResume=*/ true))
+		{
+			return true;
+		}
 	}
 
-	CleanupCompletedFutures();
+	// The child's failures are journaled apart from its writes; what it never reached failed too
+	StaleReAuditedCount = Summary.Completed - Summary.Failed;
+	StaleFailedCount = Summary.Failed + FMath::Max(0, StaleEntries.Num() - Summary.Completed);
 
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedData = MoveTemp(Data), PackageName, OutputPath]()
+	// The child leaves the manifest index and packed store alone; pick up what it wrote
+	{
+		TArray<FString> PackageNames;
+		PackageNames.Reserve(StaleEntries.Num());
+		for (const FStaleCheckEntry& Entry : StaleEntries)
 		{
-			const FString Markdown = FBlueprintAuditor::SerializeUserDefinedStructToMarkdown(MovedData);
-			FBlueprintAuditor::WriteAuditFile(Markdown, OutputPath);
-
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
-		});
-
-	PendingFutures.Add(MoveTemp(Future));
-}
+			PackageNames.Add(Entry.PackageName);
+		}
 
-void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FControlRigAuditData&& Data)
-{
-	const FString PackageName = Data.PackageName;
-	const FString OutputPath = Data.OutputPath;
+		CleanupCompletedFutures();
+		PendingFutures.Add(FAuditThreadPool::Get().Launch([PackageNames = MoveTemp(PackageNames), Token = CancellationToken]()
+		{
+			FAuditIndex::Get().RecordFromFiles(PackageNames, &Token.Get());
+			if (FAuditPackStore::IsEnabled())
+			{
+				FAuditPackStore::Get().ImportFromFiles(PackageNames, /*bOverwrite=*/ true, &Token.Get());
+			}
+		}));
+	}
 
+	if (!Summary.bFinished)
 	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
+		UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Background re-audit exited with code %d after %d/%d asset(s)"),
+			ExitCode, Summary.Completed, Total);
 	}
 
-	CleanupCompletedFutures();
-
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedData = MoveTemp(Data), PackageName, OutputPath]()
-		{
-			const FString Markdown = FBlueprintAuditor::SerializeControlRigToMarkdown(MovedData);
-			FBlueprintAuditor::WriteAuditFile(Markdown, OutputPath);
-
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
-		});
+	if (OffloadNotification.IsValid())
+	{
+		OffloadNotification->SetText(Summary.bFinished
+			? FText::Format(NSLOCTEXT("Fathom", "OffloadDone", "Fathom: re-audited {0} asset(s)"), FText::AsNumber(StaleReAuditedCount))
+			: FText::Format(NSLOCTEXT("Fathom", "OffloadFailed", "Fathom: background re-audit stopped after {0}/{1} asset(s)"),
+				FText::AsNumber(Summary.Completed), FText::AsNumber(Total)));
+		OffloadNotification->SetCompletionState(Summary.bFinished ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		OffloadNotification->ExpireAndFadeout();
+		OffloadNotification.Reset();
+	}
 
-	PendingFutures.Add(MoveTemp(Future));
+	return false;
 }
 
-void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FMaterialAuditData&& Data)
+template <typename TData>
+void UBlueprintAuditSubsystem::DispatchSerializeAndWrite(TData&& Data, FString (*Serialize)(const TData&))
 {
 	const FString PackageName = Data.PackageName;
-	const FString OutputPath = Data.OutputPath;
 
 	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
+		FScopeLock Lock(&InFlight->Lock);
+		InFlight->Packages.Add(PackageName);
 	}
 
 	CleanupCompletedFutures();
 
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedData = MoveTemp(Data), PackageName, OutputPath]()
+	TFuture<void> Future = FAuditThreadPool::Get().Launch(
+		[InFlight = InFlight, Token = CancellationToken, MovedData = MoveTemp(Data), Serialize, PackageName]()
 		{
-			const FString Markdown = FMaterialAuditor::SerializeToMarkdown(MovedData);
-			FBlueprintAuditor::WriteAuditFile(Markdown, OutputPath);
+			// A canceled task stays in flight, so shutdown puts it in the resume queue.
+			// Checked between steps: a task that has started must not outlive the shutdown wait.
+			if (Token->IsCanceled())
+			{
+				return;
+			}
+			FAuditCompactBinary::WriteSidecar(MovedData);
 
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
+			if (Token->IsCanceled())
+			{
+				return;
+			}
+			const FString Markdown = Serialize(MovedData);
+
+			if (Token->IsCanceled())
+			{
+				return;
+			}
+			FBlueprintAuditor::WriteAuditFile(Markdown, MovedData.OutputPath);
+
+			FScopeLock Lock(&InFlight->Lock);
+			InFlight->Packages.Remove(PackageName);
 		});
 
 	PendingFutures.Add(MoveTemp(Future));
 }
 
-void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FBehaviorTreeAuditData&& Data)
+void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FBlueprintAuditData&& Data)
 {
-	const FString PackageName = Data.PackageName;
-	const FString OutputPath = Data.OutputPath;
-
-	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
-	}
+	DispatchSerializeAndWrite(MoveTemp(Data), &FBlueprintAuditor::SerializeToMarkdown);
+}
 
-	CleanupCompletedFutures();
+void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FDataAssetAuditData&& Data)
+{
+	DispatchSerializeAndWrite(MoveTemp(Data), &FBlueprintAuditor::SerializeDataAssetToMarkdown);
+}
 
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedData = MoveTemp(Data), PackageName, OutputPath]()
-		{
-			const FString Markdown = FBehaviorTreeAuditor::SerializeToMarkdown(MovedData);
-			FBlueprintAuditor::WriteAuditFile(Markdown, OutputPath);
+void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FControlRigAuditData&& Data)
+{
+	DispatchSerializeAndWrite(MoveTemp(Data), &FBlueprintAuditor::SerializeControlRigToMarkdown);
+}
 
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
-		});
+void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FMaterialAuditData&& Data)
+{
+	DispatchSerializeAndWrite(MoveTemp(Data), &FMaterialAuditor::SerializeToMarkdown);
+}
 
-	PendingFutures.Add(MoveTemp(Future));
+void UBlueprintAuditSubsystem::DispatchBackgroundWrite(FBehaviorTreeAuditData&& Data)
+{
+	DispatchSerializeAndWrite(MoveTemp(Data), &FBehaviorTreeAuditor::SerializeToMarkdown);
 }
 
 void UBlueprintAuditSubsystem::DispatchBackgroundWriteTask(FAuditWriteTask&& Task)
@@ -1070,19 +1418,26 @@ void UBlueprintAuditSubsystem::DispatchBackgroundWriteTask(FAuditWriteTask&& Tas
 	const FString PackageName = Task.PackageName;
 
 	{
-		FScopeLock Lock(&InFlightLock);
-		InFlightPackages.Add(PackageName);
+		FScopeLock Lock(&InFlight->Lock);
+		InFlight->Packages.Add(PackageName);
 	}
 
 	CleanupCompletedFutures();
 
-	TFuture<void> Future = Async(EAsyncExecution::ThreadPool,
-		[this, MovedTask = MoveTemp(Task), PackageName]()
+	TFuture<void> Future = FAuditThreadPool::Get().Launch(
+		[InFlight = InFlight, Token = CancellationToken, MovedTask = MoveTemp(Task), PackageName]()
 		{
+			// Execute is the auditor's own closure, so this is the only check. A deferred
+			// gather's rooted object is released when the unrun task is destroyed.
+			if (Token->IsCanceled())
+			{
+				return; // stays in flight and goes to the resume queue
+			}
+
 			MovedTask.Execute();
 
-			FScopeLock Lock(&InFlightLock);
-			InFlightPackages.Remove(PackageName);
+			FScopeLock Lock(&InFlight->Lock);
+			InFlight->Packages.Remove(PackageName);
 		});
 
 	PendingFutures.Add(MoveTemp(Future));
@@ -1098,67 +1453,8 @@ void UBlueprintAuditSubsystem::CleanupCompletedFutures()
 
 void UBlueprintAuditSubsystem::SweepOrphanedAuditFilesInDir(const FString& BaseDir)
 {
-	TArray<FString> AuditFiles;
-	IFileManager::Get().FindFilesRecursive(AuditFiles, *BaseDir, TEXT("*.md"), true, false);
-
-	if (AuditFiles.IsEmpty())
-	{
-		return;
-	}
-
 	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-
-	int32 SweptCount = 0;
-	for (const FString& AuditFile : AuditFiles)
-	{
-		FString RelPath = AuditFile;
-		if (!RelPath.StartsWith(BaseDir))
-		{
-			continue;
-		}
-		RelPath.RightChopInline(BaseDir.Len());
-
-		if (RelPath.StartsWith(TEXT("/")) || RelPath.StartsWith(TEXT("\\")))
-		{
-			RelPath.RightChopInline(1);
-		}
-
-		if (RelPath.EndsWith(TEXT(".md")))
-		{
-			RelPath.LeftChopInline(3);
-		}
-
-		RelPath.ReplaceInline(TEXT("\\"), TEXT("/"));
-
-		const FString PackageName = FAuditFileUtils::PackageNameFromRelativeAuditPath(RelPath);
-		if (PackageName.IsEmpty())
-		{
-			continue;
-		}
-
-		// Audit policy may have changed since this file was written (e.g. external
-		// actors/objects are no longer auditable). Drop anything that no longer
-		// belongs, regardless of whether the underlying asset still exists.
-		if (!FAuditFileUtils::IsAuditablePackage(PackageName))
-		{
-			FBlueprintAuditor::DeleteAuditFile(AuditFile);
-			++SweptCount;
-			continue;
-		}
-
-		TArray<FAssetData> Assets;
-		AssetRegistry.GetAssetsByPackageName(FName(*PackageName), Assets, true);
-		if (Assets.IsEmpty())
-		{
-			FBlueprintAuditor::DeleteAuditFile(AuditFile);
-			++SweptCount;
-		}
-	}
-
-	if (SweptCount > 0)
-	{
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Swept %d orphaned audit file(s) from %s"), SweptCount, *BaseDir);
-	}
+	FAuditAssetUtils::SweepOrphanedAuditFiles(AssetRegistry, BaseDir);
 }
 
 void UBlueprintAuditSubsystem::SweepOrphanedAuditFiles()
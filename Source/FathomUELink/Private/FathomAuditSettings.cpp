@@ -0,0 +1,7 @@
+#include "FathomAuditSettings.h"
+
+UFathomAuditSettings::UFathomAuditSettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("Fathom Audit");
+}
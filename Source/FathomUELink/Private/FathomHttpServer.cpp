@@ -127,6 +127,28 @@ bool FFathomHttpServer::TryBind(int32 Port)
 		EHttpServerRequestVerbs::VERB_GET,
 		WrapHandler(&FFathomHttpServer::HandleLiveCodingCompile, TEXT("/live-coding/compile"))));
 
+	// -- Audit routes --
+
+	Handles.Add(Router->BindRoute(
+		FHttpPath(TEXT("/audit/status")),
+		EHttpServerRequestVerbs::VERB_GET,
+		WrapHandler(&FFathomHttpServer::HandleAuditStatus, TEXT("/audit/status"))));
+
+	Handles.Add(Router->BindRoute(
+		FHttpPath(TEXT("/audit/read")),
+		EHttpServerRequestVerbs::VERB_GET,
+		WrapHandler(&FFathomHttpServer::HandleAuditRead, TEXT("/audit/read"))));
+
+	Handles.Add(Router->BindRoute(
+		FHttpPath(TEXT("/audit/file")),
+		EHttpServerRequestVerbs::VERB_GET,
+		WrapHandler(&FFathomHttpServer::HandleAuditFile, TEXT("/audit/file"))));
+
+	Handles.Add(Router->BindRoute(
+		FHttpPath(TEXT("/audit/section")),
+		EHttpServerRequestVerbs::VERB_GET,
+		WrapHandler(&FFathomHttpServer::HandleAuditSection, TEXT("/audit/section"))));
+
 	// Check all handles are valid
 	for (const FHttpRouteHandle& Handle : Handles)
 	{
@@ -0,0 +1,330 @@
+#include "FathomHttpServer.h"
+#include "FathomHttpHelpers.h"
+
+#include "BlueprintAuditSubsystem.h"
+#include "Audit/AuditCache.h"
+#include "Audit/AuditFileUtils.h"
+#include "Audit/AuditPackStore.h"
+#include "Audit/AuditSectionIndex.h"
+#include "Audit/AuditThreadPool.h"
+#include "Audit/AuditWriteQueue.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "HttpResultCallback.h"
+#include "Misc/FileHelper.h"
+
+static FString GetStaleCheckPhaseString(EStaleCheckPhase Phase)
+{
+	switch (Phase)
+	{
+	case EStaleCheckPhase::Idle:                        return TEXT("Idle");
+	case EStaleCheckPhase::WaitingForRegistry:          return TEXT("WaitingForRegistry");
+	case EStaleCheckPhase::BuildingList:                return TEXT("BuildingList");
+	case EStaleCheckPhase::BackgroundHash:              return TEXT("BackgroundHash");
+	case EStaleCheckPhase::WritingStubs:                return TEXT("WritingStubs");
+	case EStaleCheckPhase::ProcessingStale:             return TEXT("ProcessingStale");
+	case EStaleCheckPhase::ProcessingStaleWithProgress: return TEXT("ProcessingStaleWithProgress");
+	case EStaleCheckPhase::OffloadedToChildProcess:     return TEXT("OffloadedToChildProcess");
+	case EStaleCheckPhase::Done:                        return TEXT("Done");
+	default:                                            return TEXT("Unknown");
+	}
+}
+
+// -- Status --
+
+bool FFathomHttpServer::HandleAuditStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const UBlueprintAuditSubsystem* AuditSubsystem = GEditor ? GEditor->GetEditorSubsystem<UBlueprintAuditSubsystem>() : nullptr;
+	if (!AuditSubsystem)
+	{
+		return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::ServiceUnavail,
+			TEXT("Audit subsystem is not available"));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ReasonsJson;
+	for (const FString& Reason : AuditSubsystem->GetPauseReasons())
+	{
+		ReasonsJson.Add(MakeShared<FJsonValueString>(Reason));
+	}
+
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("paused"), AuditSubsystem->IsAuditPaused());
+	ResponseJson->SetArrayField(TEXT("pauseReasons"), ReasonsJson);
+	ResponseJson->SetStringField(TEXT("staleCheckPhase"), GetStaleCheckPhaseString(AuditSubsystem->GetStaleCheckPhase()));
+	ResponseJson->SetNumberField(TEXT("staleRemaining"), AuditSubsystem->GetRemainingStaleCount());
+	ResponseJson->SetNumberField(TEXT("deferredSaves"), AuditSubsystem->GetDeferredSaveCount());
+	ResponseJson->SetNumberField(TEXT("schemaVersion"), FAuditFileUtils::AuditSchemaVersion);
+	ResponseJson->SetBoolField(TEXT("compressed"), FAuditFileUtils::IsCompressionEnabled());
+
+	const FAuditThreadPool::FStats PoolStats = FAuditThreadPool::Get().GetStats();
+	TSharedRef<FJsonObject> PoolJson = MakeShared<FJsonObject>();
+	PoolJson->SetNumberField(TEXT("threads"), PoolStats.NumThreads);
+	PoolJson->SetNumberField(TEXT("queued"), PoolStats.Queued);
+	PoolJson->SetNumberField(TEXT("running"), PoolStats.Running);
+	PoolJson->SetNumberField(TEXT("completed"), static_cast<double>(PoolStats.Completed));
+	ResponseJson->SetObjectField(TEXT("threadPool"), PoolJson);
+
+	const FAuditWriteStats WriteStats = FAuditFileUtils::GetWriteStats();
+	TSharedRef<FJsonObject> WritesJson = MakeShared<FJsonObject>();
+	WritesJson->SetNumberField(TEXT("written"), static_cast<double>(WriteStats.Written));
+	WritesJson->SetNumberField(TEXT("unchanged"), static_cast<double>(WriteStats.Unchanged));
+	WritesJson->SetNumberField(TEXT("failed"), static_cast<double>(WriteStats.Failed));
+	WritesJson->SetNumberField(TEXT("migrated"), static_cast<double>(WriteStats.Migrated));
+	WritesJson->SetNumberField(TEXT("cached"), static_cast<double>(WriteStats.Cached));
+	WritesJson->SetNumberField(TEXT("pending"), FAuditWriteQueue::Get().GetNumPending());
+	ResponseJson->SetObjectField(TEXT("writes"), WritesJson);
+
+	if (FAuditPackStore::IsEnabled())
+	{
+		const FAuditPackStore::FStats PackStats = FAuditPackStore::Get().GetStats();
+		TSharedRef<FJsonObject> PackJson = MakeShared<FJsonObject>();
+		PackJson->SetNumberField(TEXT("audits"), PackStats.NumEntries);
+		PackJson->SetNumberField(TEXT("bytes"), static_cast<double>(PackStats.FileSize));
+		PackJson->SetNumberField(TEXT("deadBytes"), static_cast<double>(PackStats.DeadBytes));
+		ResponseJson->SetObjectField(TEXT("packStore"), PackJson);
+	}
+
+	if (FAuditCache::IsEnabled())
+	{
+		const FAuditCache::FStats CacheStats = FAuditCache::Get().GetStats();
+		TSharedRef<FJsonObject> CacheJson = MakeShared<FJsonObject>();
+		CacheJson->SetStringField(TEXT("dir"), FAuditCache::GetCacheDir());
+		CacheJson->SetBoolField(TEXT("publish"), FAuditCache::IsPublishing());
+		CacheJson->SetNumberField(TEXT("hits"), static_cast<double>(CacheStats.Hits));
+		CacheJson->SetNumberField(TEXT("misses"), static_cast<double>(CacheStats.Misses));
+		CacheJson->SetNumberField(TEXT("stored"), static_cast<double>(CacheStats.Stored));
+		ResponseJson->SetObjectField(TEXT("sharedCache"), CacheJson);
+	}
+
+	return FathomHttp::SendJson(OnComplete, ResponseJson);
+}
+
+/** Package name from a query value; object paths (/Game/A.A) are accepted too. */
+static FString ParsePackageParam(const FString& Value)
+{
+	FString PackageName = Value.TrimStartAndEnd();
+	int32 DotIndex;
+	if (PackageName.FindLastChar(TEXT('.'), DotIndex))
+	{
+		PackageName.LeftInline(DotIndex);
+	}
+	return PackageName;
+}
+
+static bool AcceptsGzip(const FHttpServerRequest& Request)
+{
+	for (const TPair<FString, TArray<FString>>& Header : Request.Headers)
+	{
+		if (Header.Key.Equals(TEXT("Accept-Encoding"), ESearchCase::IgnoreCase))
+		{
+			for (const FString& Value : Header.Value)
+			{
+				if (Value.Contains(TEXT("gzip")))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+// -- Read --
+
+bool FFathomHttpServer::HandleAuditRead(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	// ?package=/Game/A,/Game/B ; object paths (/Game/A.A) are accepted too
+	TArray<FString> PackageNames;
+	if (const FString* PackageParam = Request.QueryParams.Find(TEXT("package")))
+	{
+		PackageParam->ParseIntoArray(PackageNames, TEXT(","));
+	}
+	for (FString& PackageName : PackageNames)
+	{
+		PackageName = ParsePackageParam(PackageName);
+	}
+	PackageNames.RemoveAll([](const FString& PackageName) { return PackageName.IsEmpty(); });
+
+	if (PackageNames.IsEmpty())
+	{
+		return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::BadRequest,
+			TEXT("Missing required 'package' query parameter"),
+			TEXT("/audit/read?package=/Game/Path/To/Asset[,/Game/Other/Asset]"));
+	}
+
+	// One mapping for the whole batch when the packed store is on; .md files otherwise
+	// and for anything the pack does not hold yet
+	TMap<FString, FString> Contents;
+	if (FAuditPackStore::IsEnabled())
+	{
+		FAuditPackStore::Get().ReadMany(PackageNames, Contents);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> AuditsJson;
+	TArray<TSharedPtr<FJsonValue>> MissingJson;
+	for (const FString& PackageName : PackageNames)
+	{
+		FString* Content = Contents.Find(PackageName);
+		FString FileContent;
+		if (!Content && FAuditFileUtils::LoadAuditFile(FAuditFileUtils::GetAuditOutputPath(PackageName), FileContent))
+		{
+			Content = &FileContent;
+		}
+
+		if (!Content)
+		{
+			MissingJson.Add(MakeShared<FJsonValueString>(PackageName));
+			continue;
+		}
+
+		TSharedRef<FJsonObject> AuditJson = MakeShared<FJsonObject>();
+		AuditJson->SetStringField(TEXT("package"), PackageName);
+		AuditJson->SetStringField(TEXT("content"), *Content);
+		AuditsJson.Add(MakeShared<FJsonValueObject>(AuditJson));
+	}
+
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetArrayField(TEXT("audits"), AuditsJson);
+	ResponseJson->SetArrayField(TEXT("missing"), MissingJson);
+	ResponseJson->SetBoolField(TEXT("packed"), FAuditPackStore::IsEnabled());
+
+	return FathomHttp::SendJson(OnComplete, ResponseJson);
+}
+
+bool FFathomHttpServer::HandleAuditFile(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const FString* PackageParam = Request.QueryParams.Find(TEXT("package"));
+	const FString PackageName = PackageParam ? ParsePackageParam(*PackageParam) : FString();
+	if (PackageName.IsEmpty())
+	{
+		return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::BadRequest,
+			TEXT("Missing required 'package' query parameter"),
+			TEXT("/audit/file?package=/Game/Path/To/Asset"));
+	}
+
+	const FString AuditPath = FAuditFileUtils::GetAuditOutputPath(PackageName);
+	const FString StoredPath = FAuditFileUtils::FindStoredAuditPath(AuditPath);
+	if (StoredPath.IsEmpty())
+	{
+		return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::NotFound,
+			FString::Printf(TEXT("No audit for %s"), *PackageName));
+	}
+
+	// Compressed on disk and the client takes gzip: send the stored bytes as they are
+	TArray<uint8> Body;
+	const bool bPassThrough = StoredPath.EndsWith(FAuditFileUtils::CompressedSuffix) && AcceptsGzip(Request);
+	if (bPassThrough)
+	{
+		if (!FFileHelper::LoadFileToArray(Body, *StoredPath))
+		{
+			return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::ServerError,
+				FString::Printf(TEXT("Failed to read %s"), *StoredPath));
+		}
+	}
+	else
+	{
+		FString Content;
+		if (!FAuditFileUtils::LoadAuditFile(AuditPath, Content))
+		{
+			return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::ServerError,
+				FString::Printf(TEXT("Failed to read %s"), *StoredPath));
+		}
+		const FTCHARToUTF8 Utf8(*Content, Content.Len());
+		Body.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(MoveTemp(Body), TEXT("text/markdown; charset=utf-8"));
+	if (bPassThrough)
+	{
+		Response->Headers.Add(TEXT("Content-Encoding"), TArray<FString>{ TEXT("gzip") });
+	}
+	OnComplete(MoveTemp(Response));
+	return true;
+}
+
+bool FFathomHttpServer::HandleAuditSection(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const FString* PackageParam = Request.QueryParams.Find(TEXT("package"));
+	const FString PackageName = PackageParam ? ParsePackageParam(*PackageParam) : FString();
+	if (PackageName.IsEmpty())
+	{
+		return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::BadRequest,
+			TEXT("Missing required 'package' query parameter"),
+			TEXT("/audit/section?package=/Game/Path/To/Asset[&name=EventGraph]"));
+	}
+	const FString* NameParam = Request.QueryParams.Find(TEXT("name"));
+	const FString SectionName = NameParam ? NameParam->TrimStartAndEnd() : FString();
+
+	// A plain .md with a section table: read the table and the one section, not the file.
+	// Anything else (small, compressed, packed) is loaded whole and sliced in memory.
+	const FString AuditPath = FAuditFileUtils::GetAuditOutputPath(PackageName);
+	const FString StoredPath = FAuditFileUtils::FindStoredAuditPath(AuditPath);
+	TArray<FAuditSectionIndex::FSection> Sections;
+	FString Content;
+	const bool bPartialRead = StoredPath == AuditPath && FAuditSectionIndex::ReadFromFile(StoredPath, Sections);
+	if (!bPartialRead)
+	{
+		const bool bLoaded = (FAuditPackStore::IsEnabled() && FAuditPackStore::Get().Read(PackageName, Content))
+			|| (!StoredPath.IsEmpty() && FAuditFileUtils::LoadAuditFile(AuditPath, Content));
+		if (!bLoaded)
+		{
+			return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::NotFound,
+				FString::Printf(TEXT("No audit for %s"), *PackageName));
+		}
+		if (!FAuditSectionIndex::Parse(Content, Sections))
+		{
+			Sections = FAuditSectionIndex::Build(Content);
+		}
+	}
+
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetStringField(TEXT("package"), PackageName);
+
+	// No name: list what can be fetched
+	if (SectionName.IsEmpty())
+	{
+		TArray<TSharedPtr<FJsonValue>> SectionsJson;
+		for (const FAuditSectionIndex::FSection& Section : Sections)
+		{
+			TSharedRef<FJsonObject> SectionJson = MakeShared<FJsonObject>();
+			SectionJson->SetStringField(TEXT("name"), Section.Name);
+			SectionJson->SetStringField(TEXT("path"), Section.Path);
+			SectionJson->SetNumberField(TEXT("level"), Section.Level);
+			SectionJson->SetNumberField(TEXT("length"), static_cast<double>(Section.Length));
+			SectionsJson.Add(MakeShared<FJsonValueObject>(SectionJson));
+		}
+		ResponseJson->SetArrayField(TEXT("sections"), SectionsJson);
+		return FathomHttp::SendJson(OnComplete, ResponseJson);
+	}
+
+	const FAuditSectionIndex::FSection* Section = FAuditSectionIndex::Find(Sections, SectionName);
+	if (!Section)
+	{
+		return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::NotFound,
+			FString::Printf(TEXT("No section '%s' in the audit of %s"), *SectionName, *PackageName),
+			FString::Printf(TEXT("/audit/section?package=%s lists the sections"), *PackageName));
+	}
+
+	FString SectionContent;
+	if (bPartialRead)
+	{
+		if (!FAuditSectionIndex::ReadSectionFromFile(StoredPath, *Section, SectionContent))
+		{
+			return FathomHttp::SendError(OnComplete, EHttpServerResponseCodes::ServerError,
+				FString::Printf(TEXT("Failed to read %s"), *StoredPath));
+		}
+	}
+	else
+	{
+		SectionContent = FAuditSectionIndex::ExtractSection(Content, *Section);
+	}
+
+	ResponseJson->SetStringField(TEXT("name"), Section->Name);
+	ResponseJson->SetStringField(TEXT("path"), Section->Path);
+	ResponseJson->SetNumberField(TEXT("level"), Section->Level);
+	ResponseJson->SetStringField(TEXT("content"), SectionContent);
+	return FathomHttp::SendJson(OnComplete, ResponseJson);
+}
@@ -1,5 +1,10 @@
 #include "FathomUELinkModule.h"
 
+#include "Audit/AuditIndex.h"
+#include "Audit/AuditPackStore.h"
+#include "Audit/AuditThreadPool.h"
+#include "Audit/AuditWriteQueue.h"
+
 DEFINE_LOG_CATEGORY(LogFathomUELink);
 
 #define LOCTEXT_NAMESPACE "FFathomUELinkModule"
@@ -28,6 +33,13 @@ void FFathomUELinkModule::ShutdownModule()
 		OnModulesChangedHandle.Reset();
 	}
 
+	// Pool first: it waits for running tasks, whose late writes then drain on their own
+	// threads, and whatever the abandoned drain task left queued is written here
+	FAuditThreadPool::Get().Shutdown();
+	FAuditWriteQueue::Get().Flush();
+	FAuditPackStore::Get().Close();
+	FAuditIndex::Get().Flush();
+
 	UE_LOG(LogFathomUELink, Log, TEXT("Fathom: FathomUELink module unloaded."));
 }
 
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audit/AuditTypes.h"
+
+struct FAssetData;
+class IAssetRegistry;
+
+/**
+ * Registry-only first tier for any auditable asset. Built from FAssetData tags and
+ * the package summary the registry already holds (class, parent class, interfaces,
+ * dependencies, disk size) without loading the asset, so stubs for a whole project
+ * can be written within seconds of registry load.
+ *
+ * Stubs carry "Tier: Stub" and no Hash line, so every staleness check treats them
+ * as stale and the full audit replaces them on the next re-audit pass.
+ */
+struct FATHOMUELINK_API FAssetStubAuditor
+{
+	/** Gather stub data from registry metadata. Never loads the asset. Must be called on the game thread. */
+	static FAssetStubAuditData GatherData(const FAssetData& Asset, IAssetRegistry& AssetRegistry);
+
+	/** Serialize gathered stub data to Markdown. Safe on any thread. */
+	static FString SerializeToMarkdown(const FAssetStubAuditData& Data);
+};
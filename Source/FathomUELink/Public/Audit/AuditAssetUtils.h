@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audit/AuditExtensionRegistry.h"
+
+struct FAssetData;
+struct FAssetStubAuditData;
+struct FStaleCheckEntry;
+class IAssetRegistry;
+class UDataTable;
+class UUserDefinedStruct;
+
+/**
+ * Asset-level helpers shared by the commandlet and the editor subsystem:
+ * deciding which registry assets are auditable, enumerating them, and
+ * loading + gathering a single asset into a write task.
+ */
+struct FATHOMUELINK_API FAuditAssetUtils
+{
+	/**
+	 * Classify a registry asset. Returns true and fills OutEntry (package, source
+	 * path, audit path, asset type) if the asset is auditable by a core auditor or
+	 * a registered extension; false otherwise.
+	 */
+	static bool TryMakeEntry(const FAssetData& Asset, FStaleCheckEntry& OutEntry);
+
+	/**
+	 * Append an entry for every auditable asset in the registry, grouped by asset
+	 * type in the same order the commandlet batches run: Blueprints, DataTables,
+	 * DataAssets, UserDefinedStructs, Materials, MaterialInstances, BehaviorTrees,
+	 * then extension types.
+	 */
+	static void CollectEntries(IAssetRegistry& AssetRegistry, TArray<FStaleCheckEntry>& OutEntries);
+
+	/**
+	 * Load the entry's asset and gather its audit data. Must be called on the game thread.
+	 * Returns a write task whose Execute closure serializes and writes the audit file
+	 * (safe on any thread), or empty if the asset failed to load or no auditor handles it.
+	 */
+	static TOptional<FAuditWriteTask> LoadAndGather(const FStaleCheckEntry& Entry);
+
+	/**
+	 * Build a write task for a loaded asset whose auditor declares bGatherIsWorkerSafe.
+	 * If the asset is fully loaded and its package is not dirty, the gather itself is
+	 * deferred into the task: the object is rooted until it has been gathered or the
+	 * task is destroyed unrun, and GC is blocked while it gathers, so the reflection
+	 * walk leaves the game thread. A deferred gather is discarded (Execute returns
+	 * false) if the package was dirtied or saved meanwhile. Otherwise the data is
+	 * gathered immediately. Must be called on the game thread.
+	 */
+	static FAuditWriteTask MakeGatherTask(const UDataTable* DataTable);
+	static FAuditWriteTask MakeGatherTask(const UUserDefinedStruct* Struct);
+
+	/**
+	 * Gather registry-only stub data for the entry's asset without loading it.
+	 * Returns false if the registry no longer has an asset in the entry's package.
+	 * Must be called on the game thread.
+	 */
+	static bool GatherStub(IAssetRegistry& AssetRegistry, const FStaleCheckEntry& Entry, FAssetStubAuditData& OutData);
+
+	/**
+	 * Serialize and write a stub, but only if no audit file exists and none is queued,
+	 * so a stub never replaces a full audit written in the meantime. Returns true if
+	 * the stub was queued.
+	 * Safe on any thread.
+	 */
+	static bool WriteStubIfMissing(const FAssetStubAuditData& Data);
+
+	/**
+	 * Compare the entry's audit file with its source. Stale if the file is missing, its
+	 * stored hash no longer matches the source .uasset, or its "AuditSchema:" header
+	 * names an older version of the auditor that wrote it (a full audit with no such
+	 * header is version 1 of the entry's auditor). An audit that is only behind on its
+	 * format is NeedsMigration instead when FAuditMigrationRegistry covers the gap and
+	 * Compact Binary sidecars, which a text migration cannot update, are off; pass it to
+	 * MigrateAudit. Entries whose source can't be hashed are Fresh. Only reads files, so
+	 * it is safe on any thread; restoring stale audits from the shared audit cache is the
+	 * caller's own pass (FAuditCache::TryRestore).
+	 */
+	static EAuditStaleness GetAuditStaleness(const FStaleCheckEntry& Entry);
+
+	/**
+	 * Rewrite a NeedsMigration audit in its auditor's current format and queue the write
+	 * (counted in FAuditWriteStats::Migrated once on disk). Returns false if the audit
+	 * can no longer be migrated; it then needs a re-audit. Safe on any thread.
+	 */
+	static bool MigrateAudit(const FStaleCheckEntry& Entry);
+
+	/**
+	 * Current format version of the named auditor ("Blueprint", "DataTable", ..., or a
+	 * registered extension's name), as written in the "AuditSchema: <Name>/<N>" header.
+	 * Returns 0 for an unknown auditor. Safe on any thread.
+	 */
+	static int32 GetSchemaVersion(const FString& Auditor);
+
+	/**
+	 * Auditors whose audits an entry of AssetType may hold, most likely first (Control
+	 * Rig blueprints are collected as Blueprints; extensions match by their AssetType).
+	 * Safe on any thread.
+	 */
+	static void GetAuditorNames(EAuditAssetType AssetType, TArray<FString>& OutAuditors);
+
+	/** Every auditor's current format version, keyed by auditor name. */
+	static TMap<FString, int32> GetSchemaVersions();
+
+	/**
+	 * Delete audit files under BaseDir whose package is no longer auditable or no
+	 * longer in the asset registry, and *.tmp files over an hour old (left by a process
+	 * killed mid-write). Returns the number of audit files deleted.
+	 */
+	static int32 SweepOrphanedAuditFiles(IAssetRegistry& AssetRegistry, const FString& BaseDir);
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audit/AuditTypes.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+/**
+ * Shared, content-addressed store of finished audits, so a team re-audits an asset once
+ * (typically on CI) instead of once per machine.
+ *
+ * Entries are keyed by the source .uasset hash and the auditor's schema version:
+ *
+ *   <CacheDir>/v<AuditSchemaVersion>/<first two hash chars>/<SourceHash>.<Auditor>-<N>.md.gz
+ *
+ * The directory (UFathomAuditSettings::SharedAuditCacheDirectory, or -AuditCache=<Dir>)
+ * can be a network share or a local folder. Entries are immutable: identical .uasset
+ * bytes audited by the same auditor version give the same audit, so a present entry is
+ * never rewritten, and concurrent publishers race harmlessly.
+ *
+ * Before loading a stale asset, the stale check's restore pass and the commandlet look
+ * it up and, on a hit, copy the cached audit into the local tree through
+ * FAuditFileUtils::WriteAuditFile.
+ * Machines with publishing on (bPublishToSharedAuditCache, or -PublishAuditCache) add
+ * every full audit they write. Thread-safe.
+ */
+class FATHOMUELINK_API FAuditCache
+{
+public:
+	struct FStats
+	{
+		int64 Hits = 0;
+		int64 Misses = 0;
+		int64 Stored = 0;
+	};
+
+	static FAuditCache& Get();
+
+	/** True when a cache directory is configured. */
+	static bool IsEnabled();
+
+	/** True when audits written on this machine are added to the cache. */
+	static bool IsPublishing();
+
+	/** Absolute cache directory, or empty when the cache is off. */
+	static FString GetCacheDir();
+
+	static FString GetEntryPath(const FString& SourceHash, const FString& Auditor, int32 Version);
+
+	/**
+	 * Copy the cached audit for Entry into its audit path if the cache holds one for
+	 * SourceHash at the current version of the asset's auditor. Returns true on a hit.
+	 */
+	bool TryRestore(const FStaleCheckEntry& Entry, const FString& SourceHash);
+
+	/** Same, hashing Entry.SourcePath first. */
+	bool TryRestore(const FStaleCheckEntry& Entry);
+
+	/**
+	 * Publish a full audit (one with Hash and AuditSchema header lines) if publishing is
+	 * on and the cache does not hold it yet. Stubs and unversioned audits are ignored.
+	 */
+	void Store(const FString& Content);
+
+	FStats GetStats() const;
+
+private:
+	FCriticalSection Lock;
+
+	/** Source hashes looked up and not found this session, so repeat checks skip the share. */
+	TSet<FString> KnownMisses;
+
+	/** Entry paths known to exist, so restored and republished audits skip the share. */
+	TSet<FString> KnownEntries;
+
+	FThreadSafeCounter64 HitCount;
+	FThreadSafeCounter64 MissCount;
+	FThreadSafeCounter64 StoredCount;
+};
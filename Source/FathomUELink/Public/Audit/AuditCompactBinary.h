@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audit/AuditTypes.h"
+
+class FCbWriter;
+
+/**
+ * Optional Compact Binary sidecar of the gathered audit data, for tools that want the
+ * node and edge graphs without parsing Markdown.
+ *
+ * Written next to the audit as <Path>.ucb (UFathomAuditSettings::bWriteCompactBinarySidecars)
+ * from the same POD structs, on the same background task, just before the Markdown is
+ * serialized. The root object carries "auditor" and "schema" (the AuditSchema name and
+ * version of the audit beside it); field names follow the AuditTypes.h members in
+ * camelCase, arrays of structs become arrays of objects, and node references stay
+ * the integer ids used in the Markdown. The layout is part of each auditor's format:
+ * change it only together with that auditor's SchemaVersion.
+ *
+ * Read with FCbObject (LoadCompactBinary) or any Compact Binary reader.
+ */
+struct FATHOMUELINK_API FAuditCompactBinary
+{
+	static constexpr const TCHAR* SidecarExtension = TEXT("ucb");
+
+	static bool IsEnabled();
+
+	/** <Path>.md -> <Path>.ucb */
+	static FString GetSidecarPath(const FString& AuditPath);
+
+	/**
+	 * Write the sidecar for gathered data if sidecars are enabled. Leaves the file alone
+	 * when its bytes are unchanged. Thread-safe; call from the serialize task.
+	 */
+	static void WriteSidecar(const FBlueprintAuditData& Data);
+	static void WriteSidecar(const FDataTableAuditData& Data);
+	static void WriteSidecar(const FDataAssetAuditData& Data);
+	static void WriteSidecar(const FUserDefinedStructAuditData& Data);
+	static void WriteSidecar(const FControlRigAuditData& Data);
+	static void WriteSidecar(const FMaterialAuditData& Data);
+	static void WriteSidecar(const FBehaviorTreeAuditData& Data);
+
+	/**
+	 * Save a finished root object as the sidecar of the audit at AuditPath. For extension
+	 * auditors with their own data types. Returns false if the write failed.
+	 */
+	static bool SaveSidecar(const FString& AuditPath, FCbWriter& Writer);
+
+	static void DeleteSidecar(const FString& AuditPath);
+};
@@ -1,8 +1,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Audit/AuditTypes.h"
+#include "HAL/CriticalSection.h"
 
-struct FStaleCheckEntry;
 class IAssetRegistry;
 
 /**
@@ -17,8 +18,11 @@ struct FATHOMUELINK_API FAuditWriteTask
 	/** Package name for in-flight dedup (e.g. "/Game/AI/ST_Enemy"). */
 	FString PackageName;
 
-	/** Closure that serializes gathered data and writes the audit file. Runs on a worker thread. */
-	TFunction<void()> Execute;
+	/**
+	 * Closure that serializes gathered data and writes the audit file. Runs on a
+	 * worker thread (or inline in the commandlet). Returns true if the write succeeded.
+	 */
+	TFunction<bool()> Execute;
 };
 
 /**
@@ -35,11 +39,14 @@ struct FATHOMUELINK_API FAuditExtensionRegistry
 	{
 		FName Name;
 
+		/** Asset type recorded on FStaleCheckEntry items this extension handles. */
+		EAuditAssetType AssetType = EAuditAssetType::DataAsset;
+
 		/**
-		 * Commandlet batch: scan asset registry, gather, serialize, write.
-		 * Accumulate into the provided counters.
+		 * Version of this extension's audit format, written as "AuditSchema: <Name>/<N>".
+		 * Bumping it makes the stale check re-audit only this extension's assets.
 		 */
-		TFunction<void(IAssetRegistry&, int32& OutSuccess, int32& OutFail, int32& OutSkip)> BatchAudit;
+		int32 SchemaVersion = 1;
 
 		/**
 		 * On-save: attempt to handle a saved object. Gather data on the game
@@ -50,13 +57,13 @@ struct FATHOMUELINK_API FAuditExtensionRegistry
 		TFunction<TOptional<FAuditWriteTask>(UObject*)> TryAuditSavedObject;
 
 		/**
-		 * Stale-check list builder: append FStaleCheckEntry items for assets
-		 * this extension handles.
+		 * Asset list builder: append FStaleCheckEntry items for assets this
+		 * extension handles. Used by the stale check and the commandlet.
 		 */
 		TFunction<void(IAssetRegistry&, TArray<FStaleCheckEntry>&)> BuildStaleCheckList;
 
 		/**
-		 * Stale re-audit: load and re-audit a single stale entry.
+		 * Load and gather a single entry (stale re-audit, commandlet runs).
 		 * Return empty if this entry's asset type is not handled.
 		 */
 		TFunction<TOptional<FAuditWriteTask>(const FStaleCheckEntry&)> ReAuditStaleEntry;
@@ -73,8 +80,14 @@ struct FATHOMUELINK_API FAuditExtensionRegistry
 	void RegisterExtension(FExtension&& Extension);
 	void UnregisterExtension(FName Name);
 
+	/** The registered extensions. Game thread only: modules register and unregister there. */
 	const TArray<FExtension>& GetExtensions() const { return Extensions; }
 
+	/** Call Visitor for each extension under the registry's read lock. Safe on any thread. */
+	void ForEachExtension(TFunctionRef<void(const FExtension&)> Visitor) const;
+
 private:
+	/** Guards Extensions against workers reading versions while a module loads or unloads. */
+	mutable FRWLock ExtensionsLock;
 	TArray<FExtension> Extensions;
 };
@@ -6,14 +6,41 @@ class UBlueprint;
 struct FEdGraphPinType;
 struct FTopLevelAssetPath;
 
+/** Outcome of FAuditFileUtils::MoveAuditFile. */
+enum class EAuditMoveResult : uint8
+{
+	Moved,              // audit now lives at the new path with a patched header
+	NoSourceAudit,      // nothing to move; the asset is audited on its next save or stale check
+	DestinationExists,  // the new path was already audited (e.g. saved first); old audit deleted
+	NeedsReAudit,       // the body mentions the old package; old audit deleted, re-audit required
+	Failed              // the new audit could not be written; the asset needs a re-audit
+};
+
+/** Process-wide WriteAuditFile counters. */
+struct FAuditWriteStats
+{
+	int64 Written = 0;
+	int64 Unchanged = 0;    // identical to the audit already on disk; write skipped
+	int64 Migrated = 0;     // brought to the current auditor format by text migration, without a load
+	int64 Cached = 0;       // copied from the shared audit cache, without a load
+	int64 Failed = 0;       // queued but could not be written (logged as errors)
+};
+
 /**
  * Cross-cutting file and path utilities for the audit system.
  */
 struct FATHOMUELINK_API FAuditFileUtils
 {
-	/** Bump when the audit format changes to invalidate all cached audit files. */
+	/**
+	 * Bump only when a change affects every audit (directory layout, shared header
+	 * lines): it moves output to a new v<N> directory and re-audits the whole project.
+	 * A single auditor's format change bumps that auditor's SchemaVersion instead.
+	 */
 	static constexpr int32 AuditSchemaVersion = 15;
 
+	/** Appended to an audit's .md path when it is stored compressed. */
+	static constexpr const TCHAR* CompressedSuffix = TEXT(".gz");
+
 	/** Human-readable type string for a Blueprint variable pin type. */
 	static FString GetVariableTypeString(const FEdGraphPinType& PinType);
 
@@ -42,7 +69,43 @@ struct FATHOMUELINK_API FAuditFileUtils
 	 */
 	static FString PackageNameFromRelativeAuditPath(const FString& RelPath);
 
-	/** Delete an audit file. Returns true if the file was deleted or did not exist. */
+	/** Same, for an absolute audit-file path (.md or .md.gz) under GetAuditBaseDir(). Returns empty on failure. */
+	static FString PackageNameFromAuditPath(const FString& AuditPath);
+
+	/**
+	 * True when audits are stored gzip-compressed (UFathomAuditSettings::bCompressAuditFiles).
+	 * Audit paths elsewhere stay the logical <Path>.md; only the file on disk is <Path>.md.gz.
+	 */
+	static bool IsCompressionEnabled();
+
+	/** On-disk path for the audit at AuditPath (<Path>.md) in the current storage mode. */
+	static FString GetStoredAuditPath(const FString& AuditPath);
+
+	/**
+	 * The file that currently holds the audit at AuditPath, <Path>.md or <Path>.md.gz
+	 * (either may exist after the storage mode changes). Returns empty if neither does.
+	 */
+	static FString FindStoredAuditPath(const FString& AuditPath);
+
+	static bool AuditFileExists(const FString& AuditPath);
+
+	/** Read an audit, decompressing it if it is stored as .md.gz. */
+	static bool LoadAuditFile(const FString& AuditPath, FString& OutContent);
+
+	/** Collect the stored audit files (.md and .md.gz) under Dir, recursively. */
+	static void FindAuditFiles(const FString& Dir, TArray<FString>& OutFiles);
+
+	/** Gzip UTF-8 audit content, as written to .md.gz files. */
+	static bool CompressAuditContent(const FString& Content, TArray<uint8>& OutCompressed);
+
+	/** Inflate a .md.gz. Fails on a gzip size trailer beyond deflate's ratio or 256 MB. */
+	static bool DecompressAuditContent(const TArray<uint8>& Compressed, FString& OutContent);
+
+	/**
+	 * Delete an audit file, stored plain or compressed (and its packed copy when the
+	 * packed store is enabled, and its .ucb sidecar). Returns true if the file was
+	 * deleted or did not exist.
+	 */
 	static bool DeleteAuditFile(const FString& FilePath);
 
 	/** Convert a package name (e.g. /Game/UI/WBP_Foo) to its .uasset file path on disk. */
@@ -58,10 +121,65 @@ struct FATHOMUELINK_API FAuditFileUtils
 	/** Compute an MD5 hash of the file at the given path. Returns empty string on failure. */
 	static FString ComputeFileHash(const FString& FilePath);
 
-	/** Write audit content to disk. Returns true on success. */
-	static bool WriteAuditFile(const FString& Content, const FString& OutputPath);
+	/** Read the source hash from an audit file's "Hash:" header. Returns empty if the file or line is missing. */
+	static FString ReadStoredSourceHash(const FString& AuditPath);
+
+	/** Same, for audit content already in memory. */
+	static FString ParseSourceHash(const FString& Content);
+
+	/**
+	 * Read the "AuditSchema: <Auditor>/<Version>" header line. Returns false if the
+	 * content has none (audits written before per-auditor versions, stubs).
+	 */
+	static bool ParseAuditSchema(const FString& Content, FString& OutAuditor, int32& OutVersion);
+
+	/** Set (or add, after the Hash line) the "AuditSchema:" header line. Returns false if the content has no header. */
+	static bool SetAuditSchema(FString& InOutContent, const FString& Auditor, int32 Version);
+
+	/**
+	 * Replace header values in audit content (the lines before the first blank line).
+	 * NewTitle, if non-empty, replaces the "# Name" line; Fields maps a header key
+	 * ("Path", "SourcePath", "Hash") to its new value. Keys absent from the header are
+	 * not added. Returns false if the content has no header.
+	 */
+	static bool RewriteAuditHeader(FString& InOutContent, const FString& NewTitle, const TMap<FString, FString>& Fields);
+
+	/**
+	 * Move a renamed asset's audit to its new output path and patch the header (name,
+	 * path, source path, and hash if the new .uasset is already on disk) instead of
+	 * re-auditing it. Waits only for queued writes to the old and new paths, and
+	 * deletes the old audit once the new one is on disk; if that write fails, the old
+	 * audit is kept and the result is Failed. Touches only the filesystem, so it is safe
+	 * on any thread.
+	 */
+	static EAuditMoveResult MoveAuditFile(const FString& OldPackageName, const FString& NewPackageName, const FString& NewObjectPath);
+
+	/**
+	 * Queue audit content for the write-behind writer (FAuditWriteQueue), which writes
+	 * the .md (or .md.gz) file and the packed copy when it is enabled. Skips the write when the
+	 * content hash matches the audit index's record for the file, so unchanged
+	 * re-audits do not wake file watchers. Returns true; failures surface in
+	 * GetWriteStats().Failed. Call WriteAuditManifest (or FAuditWriteQueue::Flush)
+	 * before reading the file back. bMigration counts the write as a migrated audit
+	 * once it reaches disk.
+	 */
+	static bool WriteAuditFile(const FString& Content, const FString& OutputPath, bool bMigration = false);
 
-	/** Write (or overwrite) audit-manifest.json in Saved/Fathom/. */
+	/**
+	 * Like WriteAuditFile, but only if OutputPath has no audit on disk and none queued,
+	 * decided atomically by the write queue. Returns true if the write was queued.
+	 */
+	static bool WriteAuditFileIfMissing(const FString& Content, const FString& OutputPath);
+
+	/** Hash of serialized audit content, as stored in the audit index. */
+	static FString HashAuditContent(const FString& Content);
+
+	static FAuditWriteStats GetWriteStats();
+
+	/**
+	 * Flush queued audit writes, then write (or overwrite) audit-manifest.json in
+	 * Saved/Fathom/, including the per-asset index (FAuditIndex).
+	 */
 	static void WriteAuditManifest();
 
 	/**
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FAuditCancellationToken;
+
+/**
+ * Per-asset index of the audit tree, published as the "assets" object of
+ * Saved/Fathom/audit-manifest.json so consumers can tell what is audited, and whether
+ * it is fresh, from one read instead of a directory walk:
+ *
+ *   "/Game/UI/WBP_Foo": { "type": "WidgetBlueprint", "path": "UI/WBP_Foo.md",
+ *                         "hash": "<source MD5>", "schema": "Blueprint/1",
+ *                         "outputHash": "<xxHash64>", "size": 5120,
+ *                         "auditedAt": "<ISO 8601 UTC>" }
+ *
+ * FAuditFileUtils::WriteAuditFile and DeleteAuditFile keep it current. Changes are
+ * flushed in batches (every FlushBatchSize changes, and on WriteAuditManifest) by
+ * writing a temp file and renaming it over the manifest. The editor, the daemon and
+ * commandlet runs may share one manifest: a flush holds <manifest>.lock, and when
+ * <manifest>.stamp shows another process wrote since, merges its own changes into
+ * the file on disk instead of overwriting it. Thread-safe.
+ */
+class FATHOMUELINK_API FAuditIndex
+{
+public:
+	struct FEntry
+	{
+		FString AssetType;
+		FString AuditPath;      // relative to the audit base dir
+		FString SourceHash;     // empty for stubs
+		FString Schema;         // "<Auditor>/<Version>" from the AuditSchema: header; empty for stubs
+		FString OutputHash;     // FAuditFileUtils::HashAuditContent of the written Markdown
+		int64 OutputSize = 0;
+		FDateTime AuditedAt;
+	};
+
+	static FAuditIndex& Get();
+
+	/**
+	 * False in the offloaded re-audit child (-FathomAuditChild): the editor owns the
+	 * manifest and picks up the child's audits with RecordFromFiles when it exits.
+	 */
+	static bool IsEnabled();
+
+	static FString GetManifestPath();
+
+	/** Record an audit just written to OutputPath. Content is used for the Hash header. */
+	void RecordWrite(const FString& PackageName, const FString& OutputPath, const FString& Content, const FString& OutputHash);
+
+	/** Output hash of PackageName's last recorded write, or empty if unknown. */
+	FString GetOutputHash(const FString& PackageName);
+
+	/** Drop PackageName from the index. */
+	void RecordDelete(const FString& PackageName);
+
+	/**
+	 * Re-read the audit files of PackageNames (an empty list walks the whole audit
+	 * tree) and update their entries, removing those whose file is gone. A whole-tree
+	 * walk completes a rebuild unless CancelToken stops it first.
+	 */
+	void RecordFromFiles(const TArray<FString>& PackageNames, const FAuditCancellationToken* CancelToken = nullptr);
+
+	/** True if the manifest on disk had no complete index for the current schema version. */
+	bool NeedsRebuild();
+
+	bool IsDirty();
+
+	/** Write the manifest if anything changed since the last flush (always, with bForce). */
+	void Flush(bool bForce = false);
+
+private:
+	void LoadLocked();
+	FString SerializeLocked() const;
+
+	/** Replace Entries with the on-disk manifest plus this process's unflushed changes. */
+	void MergeLocked(TMap<FString, FEntry>&& DiskEntries, bool bDiskComplete);
+
+	FCriticalSection Lock;
+	FCriticalSection FlushLock;
+	TMap<FString, FEntry> Entries;
+
+	/** Packages written or deleted since the last flush; they override the disk on merge. */
+	TSet<FString> DirtyKeys;
+
+	/** Stamp of this process's last manifest write. Guarded by FlushLock. */
+	FString SyncedStamp;
+	int32 UnflushedChanges = 0;
+	bool bLoaded = false;
+	bool bNeedsRebuild = false;
+
+	/** Changes recorded before a worker thread flushes on its own. */
+	static constexpr int32 FlushBatchSize = 1000;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+
+/**
+ * Checkpoint journal for long audit runs, plus the persistent quarantine list of
+ * packages that crashed a run.
+ *
+ * Journal lines, each flushed as it is written so the file survives a crash:
+ *   total <N>           entries planned for the run
+ *   begin <package>     about to load and audit a package
+ *   done <package>      its audit was written
+ *   failed <package>    its audit failed without crashing
+ *   quarantine <package> a resumed run found a begin with no matching done
+ *   end                 the run finished
+ *
+ * Quarantined packages are recorded in Saved/Fathom/audit-quarantine.txt together
+ * with their source hash, and are skipped until the .uasset changes.
+ */
+class FATHOMUELINK_API FAuditJournal
+{
+public:
+	/** Contents of a journal file as seen by a supervisor or progress reader. */
+	struct FSummary
+	{
+		int32 Total = 0;
+		/** Entries done or failed. */
+		int32 Completed = 0;
+
+		/** Of those, entries whose audit failed. */
+		int32 Failed = 0;
+		int32 Quarantined = 0;
+		bool bFinished = false;
+
+		/** Package that was begun but never completed; empty if none. */
+		FString InFlightPackage;
+	};
+
+	~FAuditJournal();
+
+	/**
+	 * Load the quarantine list and, if Path is non-empty, open the journal there.
+	 * With bResume, packages completed by the previous run are skipped and a package
+	 * it began but never completed (the one that crashed it) is quarantined.
+	 * Without bResume the journal is truncated.
+	 */
+	void Open(const FString& Path, bool bResume);
+
+	/** Write the "end" marker and close the journal. No-op if no journal is open. */
+	void Finish();
+
+	/** Record how many entries the run plans to visit. */
+	void RecordTotal(int32 Total);
+
+	void BeginEntry(const FString& PackageName);
+	/** Close the package's begin line: "done" if its audit was written, "failed" otherwise. */
+	void CompleteEntry(const FString& PackageName, bool bWritten);
+
+	/** True if a resumed run already completed this package. */
+	bool IsCompleted(const FString& PackageName) const;
+
+	/** True if this package crashed an earlier run and its source file hasn't changed since. */
+	bool IsQuarantined(const FString& PackageName, const FString& SourcePath) const;
+
+	/** Parse a journal file without opening it for writing. */
+	static FSummary ReadSummary(const FString& Path);
+
+	/** <ProjectDir>/Saved/Fathom/audit-journal.txt */
+	static FString GetDefaultJournalPath();
+
+	/** <ProjectDir>/Saved/Fathom/audit-quarantine.txt */
+	static FString GetQuarantinePath();
+
+private:
+	void WriteLine(const FString& Line);
+	void Quarantine(const FString& PackageName);
+
+	TUniquePtr<FArchive> Writer;
+	TSet<FString> Completed;
+
+	/** Quarantined package -> source hash at the time it crashed. */
+	TMap<FString, FString> Quarantined;
+};
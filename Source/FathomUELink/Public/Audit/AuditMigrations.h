@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+/**
+ * Text migrations between versions of one auditor's format.
+ *
+ * When an auditor's SchemaVersion is bumped, every audit it wrote becomes stale. If the
+ * change can be expressed on the Markdown alone (a renamed section, a reordered or
+ * dropped table column, a reworded header line), register a migration for each step
+ * and the stale check rewrites those audits in place instead of loading the assets:
+ *
+ *   // In StartupModule, alongside the SchemaVersion bump from 3 to 4
+ *   FAuditMigrationRegistry::Get().RegisterMigration(TEXT("Material"), 3,
+ *       [](FString& Content)
+ *       {
+ *           return FAuditMigrationRegistry::RenameSection(Content, TEXT("Parameters"), TEXT("Material Parameters"));
+ *       });
+ *
+ * Sections the step does not touch are carried forward as they are. A version gap
+ * with any step missing, or a step that returns false, falls back to a full
+ * re-audit. Register during module startup and unregister on shutdown; both may
+ * run while stale checks are migrating on worker threads. Thread-safe.
+ */
+class FATHOMUELINK_API FAuditMigrationRegistry
+{
+public:
+	/** Rewrites audit content from version FromVersion to FromVersion + 1. Returns false if it can't. */
+	using FMigration = TFunction<bool(FString& InOutContent)>;
+
+	static FAuditMigrationRegistry& Get();
+
+	/** Auditor is the name in the "AuditSchema: <Auditor>/<N>" header ("Blueprint", "PCG", ...). */
+	void RegisterMigration(const FString& Auditor, int32 FromVersion, FMigration&& Migration);
+	void UnregisterMigrations(const FString& Auditor);
+
+	/**
+	 * Chain the registered steps from FromVersion to ToVersion and set the AuditSchema
+	 * header to ToVersion. InOutContent is left untouched unless every step succeeds.
+	 */
+	bool Migrate(const FString& Auditor, int32 FromVersion, int32 ToVersion, FString& InOutContent) const;
+
+	/** True if a step is registered for every version from FromVersion to ToVersion. */
+	bool CanMigrate(const FString& Auditor, int32 FromVersion, int32 ToVersion) const;
+
+	/** Migrated audits written to disk this session. */
+	int64 GetNumMigrated() const { return MigratedCount.GetValue(); }
+
+	/** Called by FAuditWriteQueue once a migrated audit is on disk. */
+	void NotifyMigrated() { MigratedCount.Increment(); }
+
+	// -- Section helpers for migrations. Sections are "## Heading" blocks. --
+
+	/**
+	 * Find the "## Heading" section. OutStart is the start of the heading line, OutEnd
+	 * the start of the next "## " heading (or the end of the content).
+	 */
+	static bool FindSection(const FString& Content, const FString& Heading, int32& OutStart, int32& OutEnd);
+
+	/** Replace the whole section (heading included) with NewSection. */
+	static bool ReplaceSection(FString& InOutContent, const FString& Heading, const FString& NewSection);
+
+	static bool RemoveSection(FString& InOutContent, const FString& Heading);
+
+	static bool RenameSection(FString& InOutContent, const FString& Heading, const FString& NewHeading);
+
+private:
+	static FString MakeKey(const FString& Auditor, int32 FromVersion);
+
+	/** Guards Migrations: written on module load/unload, read by Migrate on any thread. */
+	mutable FRWLock MigrationsLock;
+	TMap<FString, FMigration> Migrations;
+	FThreadSafeCounter64 MigratedCount;
+};
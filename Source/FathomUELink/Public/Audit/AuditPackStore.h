@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FAuditCancellationToken;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Optional packed mirror of the audit tree (UFathomAuditSettings::bPackedAuditStore).
+ * Every audit written to <AuditBaseDir>/<Path>.md is also appended to a single data
+ * file, audit.pack, with a sorted index beside it in audit.pack.idx. Reading many
+ * audits then costs one memory mapping instead of one file open each.
+ *
+ * audit.pack is a sequence of records:
+ *   uint32 Magic ('FAR1'), uint32 KeyBytes, uint32 DataBytes (0xFFFFFFFF = removed),
+ *   UTF-8 package name, UTF-8 audit Markdown.
+ * Replacing an audit appends a new record; the old one becomes dead space that
+ * compaction reclaims once it outweighs the live data.
+ *
+ * audit.pack.idx is rewritten atomically (temp file + rename):
+ *   uint32 Magic ('FAI1'), uint32 Version, int64 PackBytes, uint32 Count,
+ *   then Count entries sorted by package name: uint32 KeyBytes, UTF-8 key,
+ *   int64 DataOffset, uint32 DataBytes.
+ * The index is flushed periodically, not per write. Readers use it for the first
+ * PackBytes of the pack and scan the records after that. Writes arrive in batches
+ * (one per write-queue drain, or per import chunk), each appended through one open
+ * of the pack; the mapping is dropped for the append and remade on the next read.
+ *
+ * The .md files remain the source of truth for staleness checks; the pack is a
+ * read-optimized copy. Thread-safe.
+ */
+class FATHOMUELINK_API FAuditPackStore
+{
+public:
+	struct FStats
+	{
+		int32 NumEntries = 0;
+		int64 FileSize = 0;
+		int64 DeadBytes = 0;
+	};
+
+	static FAuditPackStore& Get();
+
+	FAuditPackStore();
+	~FAuditPackStore();
+
+	/**
+	 * True when the packed store setting is on and this is not a commandlet: the editor
+	 * owns the pack. Audits written by commandlets reach it when the editor imports them
+	 * (the offloaded re-audit child) or writes them again.
+	 */
+	static bool IsEnabled();
+
+	static FString GetPackPath();
+	static FString GetIndexPath();
+
+	/** Add or replace the audit for PackageName. */
+	bool Write(const FString& PackageName, const FString& Content);
+
+	/**
+	 * Add or replace several audits (package name to content) through one append of the
+	 * pack, as the write queue does per drain. Returns false if nothing was appended.
+	 */
+	bool WriteMany(const TMap<FString, FString>& Contents);
+
+	/** Drop the audit for PackageName. Returns true if it was present. */
+	bool Remove(const FString& PackageName);
+
+	/** Read one audit. Returns false if the package has no packed audit. */
+	bool Read(const FString& PackageName, FString& OutContent);
+
+	/** Read several audits through one mapping. Returns the number found. */
+	int32 ReadMany(const TArray<FString>& PackageNames, TMap<FString, FString>& OutContents);
+
+	/**
+	 * Copy the .md audits for PackageNames into the pack (removing packages whose file
+	 * is gone). Without bOverwrite, packages already in the pack are skipped.
+	 * An empty PackageNames imports the whole audit tree. Stops early if CancelToken
+	 * is canceled. Returns the number written.
+	 */
+	int32 ImportFromFiles(const TArray<FString>& PackageNames, bool bOverwrite,
+		const FAuditCancellationToken* CancelToken = nullptr);
+
+	/** Rewrite the pack with only live records, sorted by package name. */
+	bool Compact();
+
+	/** Write the index if any record was appended since the last flush. */
+	void Flush();
+
+	/** Flush and release the mapping. The store reopens on next use. */
+	void Close();
+
+	FStats GetStats();
+
+private:
+	struct FEntry
+	{
+		int64 DataOffset = 0;
+		uint32 DataSize = 0;
+		uint32 RecordSize = 0;
+	};
+
+	bool OpenLocked();
+	bool LoadIndexLocked(int64 PackSize, int64& OutIndexedBytes);
+	int64 ScanRecordsLocked(int64 From, int64 PackSize);
+	/** One record to append: the package's audit, or a removal marker for a null Content. */
+	struct FRecordRef
+	{
+		const FString* PackageName = nullptr;
+		const FString* Content = nullptr;
+	};
+
+	/** Append Records through one file writer. All or nothing: returns false if the write failed. */
+	bool AppendLocked(TConstArrayView<FRecordRef> Records);
+	bool MapLocked();
+	void UnmapLocked();
+	bool WriteIndexLocked();
+	bool CompactLocked();
+	void CompactIfWastefulLocked();
+
+	FCriticalSection Lock;
+	TMap<FString, FEntry> Entries;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	int64 FileSize = 0;
+	int64 DeadBytes = 0;
+	int32 UnflushedRecords = 0;
+	bool bOpened = false;
+
+	static constexpr uint32 RecordMagic = 0x31524146;   // 'FAR1'
+	static constexpr uint32 IndexMagic = 0x31494146;    // 'FAI1'
+	static constexpr uint32 IndexVersion = 1;
+	static constexpr uint32 RemovedMarker = 0xFFFFFFFF;
+	static constexpr int64 RecordHeaderSize = 3 * sizeof(uint32);
+
+	/** Audit files ImportFromFiles reads before appending them in one go. */
+	static constexpr int32 ImportBatchSize = 256;
+
+	/** Records appended before the index is rewritten. Unindexed records are recovered by scanning. */
+	static constexpr int32 IndexFlushInterval = 256;
+
+	/** Compact once dead records exceed both this size and the live data. */
+	static constexpr int64 CompactMinDeadBytes = 8 * 1024 * 1024;
+};
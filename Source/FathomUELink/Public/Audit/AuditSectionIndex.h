@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Byte-offset table of contents for large audits, so a reader can fetch one graph or
+ * table without reading (or tokenizing) the whole file.
+ *
+ * FAuditFileUtils::WriteAuditFile appends it to every audit of at least
+ * MinIndexedChars characters, whichever auditor produced it, as two trailing comment
+ * lines that Markdown renderers hide:
+ *
+ *   <!-- fathom-sections [{"name":"EventGraph","path":"Graphs/EventGraph","level":3,"offset":5120,"length":20480},...] -->
+ *   <!-- fathom-sections-at 81234 -->
+ *
+ * A section runs from its heading line to the next heading of the same or a higher
+ * level. Offsets and lengths are in bytes of the UTF-8 Markdown (for .md.gz, of the
+ * decompressed content). The last line gives the offset of the table itself, so a
+ * reader seeks to the end of the file, then to the table, then to the section.
+ */
+struct FATHOMUELINK_API FAuditSectionIndex
+{
+	struct FSection
+	{
+		FString Name;       // heading text
+		FString Path;       // enclosing headings and this one, joined with '/'
+		int32 Level = 2;    // number of '#'
+		int64 Offset = 0;
+		int64 Length = 0;
+	};
+
+	/** Audits shorter than this are read whole anyway and get no table. */
+	static constexpr int32 MinIndexedChars = 16 * 1024;
+
+	/** Index the "## " and deeper headings of Markdown (outside code fences). */
+	static TArray<FSection> Build(const FString& Markdown);
+
+	/** Replace any existing table with a fresh one if the content is large enough. */
+	static void Attach(FString& InOutMarkdown);
+
+	/** Remove the table, if any. */
+	static void Strip(FString& InOutMarkdown);
+
+	/** Read the table from content. Returns false if it has none. */
+	static bool Parse(const FString& Markdown, TArray<FSection>& OutSections);
+
+	/**
+	 * Read the table of a plain .md audit from its tail, without loading the rest.
+	 * Returns false if the file has no table.
+	 */
+	static bool ReadFromFile(const FString& FilePath, TArray<FSection>& OutSections);
+
+	/** Read one section's bytes from a plain .md audit. */
+	static bool ReadSectionFromFile(const FString& FilePath, const FSection& Section, FString& OutText);
+
+	/** Slice one section out of content already in memory. */
+	static FString ExtractSection(const FString& Markdown, const FSection& Section);
+
+	/** Match by Path first, then by Name (case-insensitive). */
+	static const FSection* Find(const TArray<FSection>& Sections, const FString& NameOrPath);
+};
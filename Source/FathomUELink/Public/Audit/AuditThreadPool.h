@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+/**
+ * Cooperative cancellation flag shared between the game thread and queued Fathom
+ * tasks. Tasks check it before starting work (and between items in long loops).
+ */
+class FAuditCancellationToken
+{
+public:
+	void Cancel() { bCanceled.store(true, std::memory_order_relaxed); }
+	bool IsCanceled() const { return bCanceled.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<bool> bCanceled{false};
+};
+
+/**
+ * Dedicated low-priority thread pool for Fathom background work (stale-check
+ * hashing, audit serialization and writes). Keeps bulk audits off GThreadPool,
+ * which the editor shares with DDC, asset compilation and shader work.
+ *
+ * Created on first use with UFathomAuditSettings::AuditThreadCount threads at
+ * TPri_Lowest; destroyed on module shutdown and not recreated after it.
+ */
+class FATHOMUELINK_API FAuditThreadPool
+{
+public:
+	/** Queue depth and throughput counters. */
+	struct FStats
+	{
+		int32 NumThreads = 0;
+		int32 Queued = 0;
+		int32 Running = 0;
+		int64 Completed = 0;
+	};
+
+	static FAuditThreadPool& Get();
+
+	/**
+	 * Run Callable on the Fathom pool. Returns a future for its result. After Shutdown
+	 * the pool is not recreated: Callable runs on the calling thread instead.
+	 */
+	template <typename CallableType>
+	auto Launch(CallableType&& Callable) -> TFuture<decltype(Forward<CallableType>(Callable)())>
+	{
+		using ResultType = decltype(Forward<CallableType>(Callable)());
+		{
+			// Held while queueing so Shutdown cannot destroy the pool under us
+			FScopeLock Lock(&PoolLock);
+			if (FQueuedThreadPool* QueuedPool = GetPoolLocked())
+			{
+				QueuedCount.Increment();
+				return AsyncPool(*QueuedPool, [this, Callable = Forward<CallableType>(Callable)]() mutable
+				{
+					QueuedCount.Decrement();
+					RunningCount.Increment();
+					ON_SCOPE_EXIT
+					{
+						RunningCount.Decrement();
+						CompletedCount.Increment();
+					};
+					return Callable();
+				});
+			}
+		}
+
+		TPromise<ResultType> Promise;
+		TFuture<ResultType> Future = Promise.GetFuture();
+		SetPromiseValue(Promise, Callable);
+		return Future;
+	}
+
+	FStats GetStats() const;
+
+	/** True once Shutdown has run; Launch then runs work inline. */
+	bool IsShutDown() const { return bShutDown.load(std::memory_order_acquire); }
+
+	/**
+	 * Destroy the pool. Running tasks finish; queued tasks are abandoned. The pool lock
+	 * is released before waiting, so a running task may still call Launch.
+	 */
+	void Shutdown();
+
+private:
+	/** The pool, created on first use; null after Shutdown. PoolLock must be held. */
+	FQueuedThreadPool* GetPoolLocked();
+
+	FCriticalSection PoolLock;
+	FQueuedThreadPool* Pool = nullptr;
+	int32 NumThreads = 0;
+	std::atomic<bool> bShutDown{false};
+
+	FThreadSafeCounter QueuedCount;
+	FThreadSafeCounter RunningCount;
+	FThreadSafeCounter64 CompletedCount;
+
+	/** Serializing a large Blueprint audit builds deep strings; the engine default of 32 KB is too tight. */
+	static constexpr uint32 ThreadStackSize = 256 * 1024;
+};
@@ -2,6 +2,37 @@
 
 #include "CoreMinimal.h"
 
+/** The type of asset being audited. */
+enum class EAuditAssetType : uint8
+{
+	Blueprint,
+	DataTable,
+	DataAsset,
+	UserDefinedStruct,
+	ControlRig,
+	Material,
+	BehaviorTree,
+	StateTree,
+	PCG
+};
+
+/** Per-asset work item: collected from the asset registry, checked for staleness, then re-audited. */
+struct FStaleCheckEntry
+{
+	FString PackageName;
+	FString SourcePath;
+	FString AuditPath;
+	EAuditAssetType AssetType = EAuditAssetType::Blueprint;
+};
+
+/** What the stale check found for one entry's audit file. */
+enum class EAuditStaleness : uint8
+{
+	Fresh,
+	NeedsMigration,  // source unchanged, format behind by steps FAuditMigrationRegistry covers
+	Stale
+};
+
 // --- POD audit data structs (no UObject pointers, safe to move across threads) ---
 
 struct FVariableAuditData
@@ -360,3 +391,21 @@ struct FBehaviorTreeAuditData
 	TArray<FBlackboardKeyAuditData> BlackboardKeys;
 	FBTNodeAuditData RootNode;
 };
+
+// --- Registry stub audit data ---
+
+struct FAssetStubAuditData
+{
+	FString Name;
+	FString Path;
+	FString PackageName;
+	FString AssetClass;        // "/Script/Engine.Blueprint"
+	FString ParentClass;       // Blueprints only, from the ParentClass tag
+	FString NativeParentClass; // Blueprints only, from the NativeParentClass tag
+	FString SourceFilePath;
+	FString OutputPath;
+	int64 DiskSize = -1;       // from the registry's package data; -1 if unknown
+	int32 ReferencerCount = 0; // hard package referencers; used to prioritize the full audit
+	TArray<FString> Interfaces;
+	TArray<FString> Dependencies;  // hard package dependencies, /Script/ excluded
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+/**
+ * Write-behind stage for audit files. FAuditFileUtils::WriteAuditFile hands serialized
+ * audits to Enqueue and returns; a single drain task on FAuditThreadPool writes them.
+ *
+ * Each drain takes everything queued, sorts it by path so writes to one directory
+ * are grouped, and creates a directory only the first time it is seen (later writes
+ * skip the existence check). Every file is written to <Path>.<Guid>.tmp and renamed
+ * over the target, so readers never see a half-written audit and processes sharing the
+ * tree never share a temp file. With compressed storage the file
+ * is gzipped to <Path>.md.gz instead. Repeated writes to a path still in the queue
+ * coalesce into the latest content.
+ *
+ * The audit index and packed store are updated once the file is on disk. Call Flush
+ * before anything that needs the files (the manifest, copies, shutdown). Thread-safe.
+ */
+class FATHOMUELINK_API FAuditWriteQueue
+{
+public:
+	static FAuditWriteQueue& Get();
+
+	/**
+	 * Queue Content for OutputPath. PackageName (may be empty) keys the index and pack
+	 * entries; OutputHash is FAuditFileUtils::HashAuditContent(Content).
+	 * Returns false if the index already records OutputHash for the package, the file
+	 * exists and no write to it is pending: nothing was queued. bMigration marks a text
+	 * migration, counted by FAuditMigrationRegistry once the file is written.
+	 */
+	bool Enqueue(const FString& OutputPath, const FString& PackageName, const FString& Content, const FString& OutputHash,
+		bool bMigration = false);
+
+	/**
+	 * Queue Content for OutputPath only if no write to it is queued or being written and
+	 * no audit file exists, checked under the queue's lock so a full audit enqueued
+	 * concurrently is never replaced. For stubs. Returns true if the write was queued.
+	 */
+	bool EnqueueIfAbsent(const FString& OutputPath, const FString& PackageName, const FString& Content, const FString& OutputHash);
+
+	/** Drop a pending write to OutputPath (the audit is being deleted). */
+	void Cancel(const FString& OutputPath);
+
+	/**
+	 * Block until every queued write is on disk. Drains on the calling thread when no
+	 * drain is running, so it is safe from pool threads.
+	 */
+	void Flush();
+
+	/**
+	 * Block until no write to OutputPath is queued or being written, draining on the
+	 * calling thread like Flush. Returns false if the last write to it failed. For
+	 * callers that must know the audit is on disk (the commandlet's journal).
+	 */
+	bool WaitForWrite(const FString& OutputPath);
+
+	/** True if a write to OutputPath is queued or being written. */
+	bool IsPending(const FString& OutputPath);
+
+	int32 GetNumPending();
+	int64 GetNumWritten() const { return WrittenCount.GetValue(); }
+	int64 GetNumFailed() const { return FailedCount.GetValue(); }
+
+private:
+	struct FPendingWrite
+	{
+		FString OutputPath;
+		FString PackageName;
+		FString Content;
+		FString OutputHash;
+		bool bMigration = false;
+	};
+
+	/**
+	 * Add or replace the pending write. Lock must be held. Returns true if the caller
+	 * must call ScheduleDrain once it has released the lock.
+	 */
+	bool AddLocked(const FString& OutputPath, const FString& PackageName, const FString& Content, const FString& OutputHash,
+		bool bMigration);
+
+	/** Launch DrainAll on the pool, or run it inline once the pool is shut down. */
+	void ScheduleDrain();
+
+	void DrainAll();
+
+	/** Write one batch if no other thread is draining. Returns false if one is. */
+	bool DrainOnce();
+
+	/** Write Batch; OutFailedPaths receives the writes that failed. */
+	void WriteBatch(TArray<FPendingWrite>& Batch, TArray<FString>& OutFailedPaths);
+	bool WriteFile(const FPendingWrite& Write, const FString& StoredPath);
+	void EnsureDirectory(const FString& Dir);
+
+	FCriticalSection Lock;
+	TMap<FString, FPendingWrite> Pending;
+	TSet<FString> InFlight;
+
+	/** Paths whose last write failed; cleared by the next write to the path. */
+	TSet<FString> FailedPaths;
+	bool bDraining = false;
+	bool bDrainScheduled = false;
+
+	/** Directories created or seen by the drainer. Only touched while bDraining is held. */
+	TSet<FString> KnownDirectories;
+
+	FThreadSafeCounter64 WrittenCount;
+	FThreadSafeCounter64 FailedCount;
+};
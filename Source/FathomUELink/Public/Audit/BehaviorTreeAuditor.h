@@ -11,6 +11,9 @@ class UBehaviorTree;
  */
 struct FATHOMUELINK_API FBehaviorTreeAuditor
 {
+	/** Version of this auditor's Markdown. Bump it on a format change to re-audit only these assets. */
+	static constexpr int32 SchemaVersion = 1;
+
 	/** Gather all audit data from a BehaviorTree into a POD struct. Must be called on the game thread. */
 	static FBehaviorTreeAuditData GatherData(const UBehaviorTree* BT);
 
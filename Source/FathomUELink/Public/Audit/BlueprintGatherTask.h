@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audit/AuditTypes.h"
+#include "UObject/GCObject.h"
+
+class UBlueprint;
+class UObject;
+
+/**
+ * Resumable, time-sliced FBlueprintGraphAuditor::GatherBlueprintData. The first step
+ * gathers the metadata, then each step gathers whole graphs until its time budget is
+ * spent, so one huge Blueprint spreads across several frames instead of one long hitch.
+ *
+ * The Blueprint is kept alive for the task's lifetime. If it is modified or recompiled
+ * between steps, the partial data is discarded and the gather restarts; after
+ * MaxRestarts it finishes in one go so a Blueprint that keeps changing still gets audited.
+ * Game thread only.
+ */
+class FATHOMUELINK_API FBlueprintGatherTask : public FGCObject
+{
+public:
+	explicit FBlueprintGatherTask(UBlueprint* InBlueprint);
+	virtual ~FBlueprintGatherTask() override;
+
+	/**
+	 * Gather until finished or BudgetSeconds have elapsed. Always makes progress by
+	 * at least one graph. Returns true once the data is complete.
+	 */
+	bool Step(double BudgetSeconds);
+
+	/** Move the completed data out. Only valid after Step returned true. */
+	FBlueprintAuditData TakeData();
+
+	const FString& GetPackageName() const { return PackageName; }
+	int32 GetRestartCount() const { return RestartCount; }
+
+	//~ FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+
+private:
+	enum class EStage : uint8
+	{
+		Metadata,
+		EventGraphs,
+		FunctionGraphs,
+		MacroGraphs,
+		Done
+	};
+
+	void Restart();
+	void OnObjectModified(UObject* Object);
+	void OnBlueprintCompiled(UBlueprint* CompiledBlueprint);
+
+	TObjectPtr<UBlueprint> Blueprint;
+	FString PackageName;
+	FBlueprintAuditData Data;
+	EStage Stage = EStage::Metadata;
+	int32 GraphIndex = 0;
+	int32 RestartCount = 0;
+	bool bModifiedSinceStep = false;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle CompiledHandle;
+
+	static constexpr int32 MaxRestarts = 3;
+};
@@ -12,11 +12,21 @@ class UWidget;
  */
 struct FATHOMUELINK_API FBlueprintGraphAuditor
 {
+	/** Version of this auditor's Markdown. Bump it on a format change to re-audit only these assets. */
+	static constexpr int32 SchemaVersion = 1;
+
 	// --- Game-thread gather (reads UObject pointers, populates POD structs) ---
 
 	/** Gather all audit data from a Blueprint into a POD struct. Must be called on the game thread. */
 	static FBlueprintAuditData GatherBlueprintData(const UBlueprint* BP);
 
+	/**
+	 * Gather everything except the event/function/macro graphs (metadata, variables,
+	 * overrides, interfaces, components, timelines, widget tree). Used with GatherGraphData
+	 * by FBlueprintGatherTask to spread a large Blueprint across frames. Must be called on the game thread.
+	 */
+	static FBlueprintAuditData GatherBlueprintMetadata(const UBlueprint* BP);
+
 	/** Gather audit data from a single graph. Must be called on the game thread. */
 	static FGraphAuditData GatherGraphData(const UEdGraph* Graph);
 
@@ -10,6 +10,9 @@ class UControlRigBlueprint;
  */
 struct FATHOMUELINK_API FControlRigAuditor
 {
+	/** Version of this auditor's Markdown. Bump it on a format change to re-audit only these assets. */
+	static constexpr int32 SchemaVersion = 1;
+
 	/** Gather all audit data from a ControlRig Blueprint into a POD struct. Must be called on the game thread. */
 	static FControlRigAuditData GatherData(const UControlRigBlueprint* CRBP);
 
@@ -10,7 +10,20 @@ class UDataTable;
  */
 struct FATHOMUELINK_API FDataTableAuditor
 {
-	/** Gather all audit data from a DataTable into a POD struct. Must be called on the game thread. */
+	/** Version of this auditor's Markdown. Bump it on a format change to re-audit only these assets. */
+	static constexpr int32 SchemaVersion = 1;
+
+	/**
+	 * GatherData only walks reflection data and exports row values, so for a fully
+	 * loaded, unmodified table it may run on a worker while GC is blocked.
+	 * See FAuditAssetUtils::MakeGatherTask.
+	 */
+	static constexpr bool bGatherIsWorkerSafe = true;
+
+	/**
+	 * Gather all audit data from a DataTable into a POD struct. Call on the game thread,
+	 * or on a worker under the conditions of bGatherIsWorkerSafe.
+	 */
 	static FDataTableAuditData GatherData(const UDataTable* DataTable);
 
 	/** Serialize gathered DataTable data to Markdown. Computes SourceFileHash from SourceFilePath. Safe on any thread. */
@@ -10,6 +10,9 @@ class UMaterialInterface;
  */
 struct FATHOMUELINK_API FMaterialAuditor
 {
+	/** Version of this auditor's Markdown. Bump it on a format change to re-audit only these assets. */
+	static constexpr int32 SchemaVersion = 1;
+
 	/** Gather all audit data from a material into a POD struct. Must be called on the game thread. */
 	static FMaterialAuditData GatherData(const UMaterialInterface* Material);
 
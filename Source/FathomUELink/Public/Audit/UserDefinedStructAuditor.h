@@ -10,7 +10,20 @@ class UUserDefinedStruct;
  */
 struct FATHOMUELINK_API FUserDefinedStructAuditor
 {
-	/** Gather all audit data from a UserDefinedStruct into a POD struct. Must be called on the game thread. */
+	/** Version of this auditor's Markdown. Bump it on a format change to re-audit only these assets. */
+	static constexpr int32 SchemaVersion = 1;
+
+	/**
+	 * GatherData only walks the struct's fields and default instance, so for a fully
+	 * loaded, unmodified struct it may run on a worker while GC is blocked.
+	 * See FAuditAssetUtils::MakeGatherTask.
+	 */
+	static constexpr bool bGatherIsWorkerSafe = true;
+
+	/**
+	 * Gather all audit data from a UserDefinedStruct into a POD struct. Call on the game
+	 * thread, or on a worker under the conditions of bGatherIsWorkerSafe.
+	 */
 	static FUserDefinedStructAuditData GatherData(const UUserDefinedStruct* Struct);
 
 	/** Serialize gathered UserDefinedStruct data to Markdown. Computes SourceFileHash from SourceFilePath. Safe on any thread. */
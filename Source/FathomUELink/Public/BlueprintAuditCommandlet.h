@@ -2,19 +2,51 @@
 
 #include "CoreMinimal.h"
 #include "Commandlets/Commandlet.h"
+#include "Audit/AuditJournal.h"
 #include "BlueprintAuditCommandlet.generated.h"
 
+class IAssetRegistry;
+
 /**
  * Commandlet that analyzes Blueprint assets and outputs a Markdown summary.
  *
  * Usage:
- *   UnrealEditor-Cmd.exe Project.uproject -run=BlueprintAudit [-AssetPath=/Game/Path/To/BP] [-Output=path.md]
+ *   UnrealEditor-Cmd.exe Project.uproject -run=BlueprintAudit [-AssetPath=/Game/A,/Game/B] [-Output=path.md] [-Paths=/Game/UI]
+ *
+ * If -AssetPath is omitted, all auditable assets in the project are audited
+ * and each gets its own .md file under Saved/Fathom/Audit/. -Paths=/Game/UI,/MyPlugin/AI
+ * limits the registry scan and the audit to those package path roots. Assets with no
+ * audit yet first get a registry-only stub (Tier: Stub) that the full pass replaces.
+ *
+ * -Schedule=Dependencies (all-assets, -ChangedFiles and daemon sweep runs) groups
+ * assets that share a hard dependency (base Blueprint, common struct, master
+ * material) and collects garbage only between groups, so each shared dependency
+ * loads once per group instead of once per 50 assets.
+ *
+ * -Supervise runs the same command line in a child process that records progress
+ * in a journal (-Journal=path, default Saved/Fathom/audit-journal.txt). If the child
+ * crashes while loading an asset, that asset is quarantined and the child is
+ * restarted with -Resume (up to -MaxRestarts=N, default 10), skipping finished work.
+ * Quarantined assets stay skipped in later batch runs until their .uasset changes.
+ *
+ * If -AssetPath is provided, only the listed assets (comma-separated package or
+ * object paths, any auditable type) are audited, each to its canonical audit path.
+ * With a single asset, -Output additionally copies its audit to the given file.
  *
- * If -AssetPath is omitted, all Blueprints in the project are audited
- * and each gets its own .md file under Saved/Fathom/Audit/Blueprints/.
+ * If -ChangedFiles=list.txt is provided, only the listed assets are audited.
+ * Each line is a package path, object path, or on-disk .uasset/.umap path
+ * (absolute or project-relative). Listed files that no longer exist have their
+ * audit files deleted. Add -IncludeDependents to also re-audit assets that hard
+ * reference a changed Blueprint or UserDefinedStruct (child Blueprints, struct users).
  *
- * If -AssetPath is provided, a single file is written to -Output
- * (defaults to <ProjectDir>/BlueprintAudit.md).
+ * If -Daemon is provided, the engine and asset registry are initialized once and
+ * jobs are then read from stdin, one per line:
+ *   audit <path>[,<path>...]         same as -AssetPath
+ *   changed <list.txt> [dependents]  same as -ChangedFiles [-IncludeDependents]
+ *   sweep [<root>[,<root>...]]       re-audit stale assets, delete orphaned audits
+ *   status                           report uptime, job count, and audit directory
+ *   quit                             exit (EOF on stdin also exits)
+ * Each job gets one "FATHOM-DAEMON {json}" response line on stdout.
  */
 UCLASS()
 class FATHOMUELINK_API UBlueprintAuditCommandlet : public UCommandlet
@@ -24,4 +56,62 @@ class FATHOMUELINK_API UBlueprintAuditCommandlet : public UCommandlet
 public:
 	UBlueprintAuditCommandlet();
 	virtual int32 Main(const FString& Params) override;
+
+	/** Per-run counters. Modes log them; the daemon also returns them in each job response. */
+	struct FRunStats
+	{
+		int32 Written = 0;
+		int32 Deleted = 0;
+
+		/** Behind on format only and rewritten by text migration, without a load. */
+		int32 Migrated = 0;
+
+		/** Of Written: copied from the shared audit cache instead of loaded. */
+		int32 Restored = 0;
+
+		/** Stale entries the shared audit cache did not have (only with a cache configured). */
+		int32 CacheMisses = 0;
+
+		int32 NotFound = 0;
+		int32 Unsupported = 0;
+		int32 Failed = 0;
+
+		/** Already completed by the run being resumed. */
+		int32 Skipped = 0;
+
+		/** Crashed an earlier run and is unchanged since. */
+		int32 Quarantined = 0;
+	};
+
+private:
+	/** Default mode: audit every auditable asset, or only those under PackagePaths. */
+	int32 RunAllAssetsMode(IAssetRegistry& AssetRegistry, const TArray<FString>& PackagePaths, FRunStats& OutStats);
+
+	/** -ChangedFiles mode: audit only the listed packages (plus dependents), delete audits for removed ones. */
+	int32 RunChangedFilesMode(IAssetRegistry& AssetRegistry, const FString& ListPath, bool bIncludeDependents, FRunStats& OutStats);
+
+	/** -AssetPath mode: audit a comma-separated list of assets of any auditable type. */
+	int32 RunAssetListMode(IAssetRegistry& AssetRegistry, const FString& AssetPathList, const FString& OutputPath, FRunStats& OutStats);
+
+	/**
+	 * Incremental sweep: rescan content roots, re-audit stale assets, delete orphaned audit files.
+	 * Non-empty PackagePaths limits the rescan and re-audit to those roots and skips the orphan sweep.
+	 */
+	int32 RunSweep(IAssetRegistry& AssetRegistry, const TArray<FString>& PackagePaths, FRunStats& OutStats);
+
+	/** -Daemon mode: search the registry once, then serve audit/changed/sweep/status/quit jobs from stdin. */
+	int32 RunDaemon(IAssetRegistry& AssetRegistry);
+
+	/**
+	 * -Supervise mode: run this commandlet's own command line in a child process with a
+	 * journal. When the child dies mid-asset, restart it with -Resume, which quarantines
+	 * that asset and skips everything already done.
+	 */
+	int32 RunSupervisor(const FString& Params);
+
+	/** -Schedule=Dependencies: order batch runs by shared hard dependencies and collect garbage between clusters. */
+	bool bClusterByDependencies = false;
+
+	/** Progress journal (-Journal/-Resume) and quarantine list for batch runs. */
+	FAuditJournal Journal;
 };
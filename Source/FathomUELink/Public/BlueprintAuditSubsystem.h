@@ -4,10 +4,15 @@
 #include "Async/Future.h"
 #include "Containers/Ticker.h"
 #include "EditorSubsystem.h"
+#include "HAL/PlatformProcess.h"
 #include "BlueprintAuditor.h"
 #include "Audit/AuditExtensionRegistry.h"
+#include "Audit/AuditThreadPool.h"
+#include "Audit/BlueprintGatherTask.h"
 #include "BlueprintAuditSubsystem.generated.h"
 
+class SNotificationItem;
+
 /** State machine phases for the startup stale check. */
 enum class EStaleCheckPhase : uint8
 {
@@ -15,34 +20,13 @@ enum class EStaleCheckPhase : uint8
 	WaitingForRegistry,
 	BuildingList,
 	BackgroundHash,
+	WritingStubs,
 	ProcessingStale,
 	ProcessingStaleWithProgress,
+	OffloadedToChildProcess,
 	Done
 };
 
-/** The type of asset being audited. */
-enum class EAuditAssetType : uint8
-{
-	Blueprint,
-	DataTable,
-	DataAsset,
-	UserDefinedStruct,
-	ControlRig,
-	Material,
-	BehaviorTree,
-	StateTree,
-	PCG
-};
-
-/** Per-entry data collected in Phase 1, consumed in Phase 2/3. */
-struct FStaleCheckEntry
-{
-	FString PackageName;
-	FString SourcePath;
-	FString AuditPath;
-	EAuditAssetType AssetType = EAuditAssetType::Blueprint;
-};
-
 /**
  * Editor subsystem that automatically audits Blueprint assets on save.
  * Hooks into UPackage::PackageSavedWithContextEvent and writes a per-file
@@ -50,7 +34,8 @@ struct FStaleCheckEntry
  *
  * On startup, runs a three-phase stale check that offloads hashing and I/O
  * to background threads and chunks game-thread work across ticks to avoid
- * freezing the editor UI.
+ * freezing the editor UI. Stale assets without an audit first get a registry-only
+ * stub (see FAssetStubAuditor), which the full audit replaces by priority.
  */
 UCLASS()
 class FATHOMUELINK_API UBlueprintAuditSubsystem : public UEditorSubsystem
@@ -62,15 +47,69 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
+	/**
+	 * True while audit work is suspended: during Play-In-Editor and while a trace
+	 * (Unreal Insights) session is recording. The stale check holds its place and
+	 * on-save re-audits are queued until the pause ends.
+	 */
+	bool IsAuditPaused() const;
+
+	/** Why audit work is suspended ("pie", "trace"). Empty when not paused. */
+	TArray<FString> GetPauseReasons() const;
+
+	EStaleCheckPhase GetStaleCheckPhase() const { return StaleCheckPhase; }
+
+	/** Stale entries the startup check has not re-audited yet. */
+	int32 GetRemainingStaleCount() const { return FMath::Max(0, StaleEntries.Num() - StaleProcessIndex); }
+
+	/** Saved packages whose re-audit is waiting for the pause to end. */
+	int32 GetDeferredSaveCount() const { return DeferredSavedPackages.Num(); }
+
 private:
 	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
 
 	/** Delete the audit file when a Blueprint asset is removed from the project. */
 	void OnAssetRemoved(const FAssetData& AssetData);
 
-	/** Delete the old-path audit file when a Blueprint asset is renamed or moved. */
+	/**
+	 * Queue a move of the old-path audit file to the renamed asset's new path. Falls
+	 * back to deleting it if the new path is not auditable.
+	 */
 	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
 
+	/**
+	 * Ticker callback: hand every queued audit move to one background task, then queue a
+	 * re-audit for each moved asset whose audit could not be carried over.
+	 */
+	bool OnAuditMoveTick(float DeltaTime);
+
+	/** Re-audit already-loaded packages through the deferred-save path. */
+	void QueueReAudits(const TArray<FString>& PackageNames);
+
+	void OnBeginPIE(const bool bIsSimulating);
+	void OnEndPIE(const bool bIsSimulating);
+
+	/** Ticker callback: flush pending audit-manifest index changes on a background thread. */
+	bool OnManifestFlushTick(float DeltaTime);
+
+	/** Ticker callback while saves are deferred: re-audits them once the pause ends. */
+	bool OnDeferredSaveTick(float DeltaTime);
+
+	/**
+	 * Re-audit every package in DeferredSavedPackages (saved while paused, or renamed
+	 * with an audit that could not be moved; already loaded, so no hitch beyond the gather).
+	 */
+	void FlushDeferredSaves();
+
+	/** Read and delete the resume queue left by the previous session into ResumeQueuePackages. */
+	void LoadResumeQueue();
+
+	/**
+	 * Write every package whose audit didn't finish (cancelled in-flight writes, the
+	 * rest of the stale list, deferred saves) to the resume queue. Called on shutdown.
+	 */
+	void SaveResumeQueue();
+
 	/** Ticker callback: drives the stale check state machine. */
 	bool OnStaleCheckTick(float DeltaTime);
 
@@ -81,6 +120,27 @@ private:
 	 */
 	void ProcessSingleStaleEntry(const FStaleCheckEntry& Entry);
 
+	/**
+	 * Small-batch path for Blueprint entries: load the Blueprint and start a
+	 * time-sliced FBlueprintGatherTask in ActiveBlueprintGather, so a huge Blueprint
+	 * is gathered over several ticks. Returns false for other types, ControlRigs,
+	 * and load failures, which go through ProcessSingleStaleEntry instead.
+	 */
+	bool BeginBlueprintGather(const FStaleCheckEntry& Entry);
+
+	/** True if the user hasn't touched the editor for IdleThresholdSeconds, or the editor isn't the foreground app. */
+	bool IsUserIdle() const;
+
+	/**
+	 * Small-batch pacing for this tick under idle-aware scheduling: full rate when the
+	 * user is idle, a trickle while they interact. Returns false if work should pause
+	 * this tick (UFathomAuditSettings::bPauseWhileActive).
+	 */
+	bool GetStalePacing(int32& OutFramesPerEntry, double& OutGatherBudgetSeconds) const;
+
+	/** Dispatch the completed ActiveBlueprintGather's data to a background write and clear it. */
+	void FinishBlueprintGather();
+
 	/**
 	 * Run the entire StaleEntries set synchronously inside an FScopedSlowTask,
 	 * showing a cancelable progress dialog. Used when the stale count is large
@@ -89,6 +149,21 @@ private:
 	 */
 	void RunStaleProcessingWithProgressDialog();
 
+	/**
+	 * Offload the StaleEntries set to a headless UnrealEditor-Cmd child running
+	 * -ChangedFiles over exactly that list, with a journal for progress. Used instead
+	 * of the progress dialog when UFathomAuditSettings::bOffloadBulkReAudit is set.
+	 * With bResume, relaunch after a crash: the child quarantines the asset that
+	 * crashed it and skips finished ones. Returns false if the child couldn't start.
+	 */
+	bool LaunchOffloadedReAudit(bool bResume);
+
+	/**
+	 * Poll the offloaded child: update the progress notification, relaunch it after a
+	 * crash, and report the result once it exits. Returns true while work remains.
+	 */
+	bool PollOffloadedReAudit();
+
 	/** Walk the audit directory and delete audit files whose source .uasset no longer exists. */
 	void SweepOrphanedAuditFiles();
 
@@ -101,42 +176,113 @@ private:
 	 * Takes ownership of Data by move.
 	 */
 	void DispatchBackgroundWrite(FBlueprintAuditData&& Data);
-	void DispatchBackgroundWrite(FDataTableAuditData&& Data);
 	void DispatchBackgroundWrite(FDataAssetAuditData&& Data);
-	void DispatchBackgroundWrite(FUserDefinedStructAuditData&& Data);
 	void DispatchBackgroundWrite(FControlRigAuditData&& Data);
 	void DispatchBackgroundWrite(FMaterialAuditData&& Data);
 	void DispatchBackgroundWrite(FBehaviorTreeAuditData&& Data);
 
-	/** Dispatch a generic write task from an extension auditor. */
+	/** Dispatch a generic write task (extension auditors, worker-gather tasks, stale re-audits). */
 	void DispatchBackgroundWriteTask(FAuditWriteTask&& Task);
 
+	/**
+	 * Shared body of the DispatchBackgroundWrite overloads: mark the package in flight,
+	 * then write the sidecar, serialize and queue the audit on the pool, checking the
+	 * cancellation token before each step.
+	 */
+	template <typename TData>
+	void DispatchSerializeAndWrite(TData&& Data, FString (*Serialize)(const TData&));
+
 	/** Remove completed futures from PendingFutures to prevent unbounded growth. */
 	void CleanupCompletedFutures();
 
 	// --- Ticker ---
 	FTSTicker::FDelegateHandle StaleCheckTickerHandle;
+	FTSTicker::FDelegateHandle DeferredSaveTickerHandle;
+	FTSTicker::FDelegateHandle ManifestFlushTickerHandle;
+	TFuture<void> ManifestFlushFuture;
+
+	// --- Rename / move ---
+	struct FAuditMove
+	{
+		FString OldPackageName;
+		FString NewPackageName;
+		FString NewObjectPath;
+	};
+
+	/** Move each audit file. Returns the new package names to re-audit: self-referencing or failed moves. */
+	static TArray<FString> RunAuditMoves(const TArray<FAuditMove>& Moves);
+
+	TArray<FAuditMove> PendingAuditMoves;
+	FTSTicker::FDelegateHandle AuditMoveTickerHandle;
+
+	/** Batch of moves running in the background; yields the packages to re-audit. */
+	TFuture<TArray<FString>> AuditMoveFuture;
+
+	// --- Pause (PIE / trace) ---
+	bool bPIEActive = false;
+	TSet<FString> DeferredSavedPackages;
 
 	// --- Stale check state machine ---
 	EStaleCheckPhase StaleCheckPhase = EStaleCheckPhase::WaitingForRegistry;
 	TArray<FStaleCheckEntry> StaleCheckEntries;
 	TArray<FStaleCheckEntry> StaleEntries;
 	int32 StaleProcessIndex = 0;
+	int32 StubProcessIndex = 0;
+	int32 StaleMigratedCount = 0;
+	int32 StaleRestoredCount = 0;
 	int32 StaleReAuditedCount = 0;
 	int32 StaleFailedCount = 0;
 	int32 AssetsSinceGC = 0;
 	int32 TickFrameCounter = 0;
 	double StaleCheckStartTime = 0.0;
 
-	/** Phase 2: background future that computes hashes and returns stale entries. */
-	TFuture<TArray<FStaleCheckEntry>> Phase2Future;
+	/** Small-batch path: Blueprint gather spread across ticks, if one is in progress. */
+	TUniquePtr<FBlueprintGatherTask> ActiveBlueprintGather;
+
+	/** Stub tier: hard referencer count per stale package, used to order the full re-audit. */
+	TMap<FString, int32> StalePriority;
+
+	/** Phase 2 outcome: entries to re-audit, and those brought current without a load. */
+	struct FPhase2Result
+	{
+		TArray<FStaleCheckEntry> Stale;
+		int32 Migrated = 0;
+
+		/** Shared audit cache lookups for the stale entries: copied in, and not found. */
+		int32 CacheHits = 0;
+		int32 CacheMisses = 0;
+	};
+
+	/** Phase 2: background future that computes hashes, migrates, and returns stale entries. */
+	TFuture<FPhase2Result> Phase2Future;
+
+	// --- Offloaded bulk re-audit ---
+	FProcHandle OffloadProc;
+	TSharedPtr<SNotificationItem> OffloadNotification;
+	double LastOffloadPollTime = 0.0;
+	int32 OffloadRestarts = 0;
 
 	// --- Background write tracking ---
 	TArray<TFuture<void>> PendingFutures;
 
+	/** Cancelled on shutdown; every background task checks it before doing work. */
+	TSharedRef<FAuditCancellationToken, ESPMode::ThreadSafe> CancellationToken = MakeShared<FAuditCancellationToken, ESPMode::ThreadSafe>();
+
+	/** Packages left unfinished by the previous session; re-audited first if still stale. */
+	TSet<FString> ResumeQueuePackages;
+
 	// --- In-flight dedup ---
-	FCriticalSection InFlightLock;
-	TSet<FString> InFlightPackages;
+	/**
+	 * Packages with an audit dispatched and not yet written. Background tasks hold it by
+	 * shared reference, never through the subsystem, so one still running after
+	 * Deinitialize's bounded wait does not touch a destroyed object.
+	 */
+	struct FInFlightSet
+	{
+		FCriticalSection Lock;
+		TSet<FString> Packages;
+	};
+	TSharedRef<FInFlightSet, ESPMode::ThreadSafe> InFlight = MakeShared<FInFlightSet, ESPMode::ThreadSafe>();
 
 	// --- Constants ---
 	/**
@@ -155,4 +301,38 @@ private:
 	static constexpr int32 SlowTaskThreshold = 25;
 
 	static constexpr int32 GCInterval = 50;
+
+	/**
+	 * Small-batch path: game-thread time per tick for gathering a Blueprint's graphs.
+	 * A Blueprint that needs longer continues on the next tick.
+	 */
+	static constexpr double GatherBudgetSeconds = 0.008;
+
+	/** Idle-aware scheduling: pacing while the user is idle (every tick, larger gather budget). */
+	static constexpr int32 IdleFramesPerStaleEntry = 1;
+	static constexpr double IdleGatherBudgetSeconds = 0.030;
+
+	/** Idle-aware scheduling: pacing while the user is interacting (roughly two entries a second at 60 fps). */
+	static constexpr int32 TrickleFramesPerStaleEntry = 30;
+
+	/**
+	 * Stub tier: entries gathered per tick. Each is a handful of registry lookups
+	 * (no load), so a few hundred fit comfortably in a frame.
+	 */
+	static constexpr int32 StubsPerTick = 250;
+
+	/** Upper bound on shutdown's wait for tasks that were mid-write when cancelled. */
+	static constexpr double ShutdownWaitSeconds = 1.0;
+
+	/** Seconds between checks for the end of a pause while saves are deferred. */
+	static constexpr float DeferredSavePollInterval = 0.5f;
+
+	/** Seconds between manifest index flushes while audits are being written. */
+	static constexpr float ManifestFlushInterval = 5.0f;
+
+	/** Seconds between polls of the offloaded child's process state and journal. */
+	static constexpr double OffloadPollInterval = 0.5;
+
+	/** Crash relaunches of the offloaded child before the rest is left for the next launch. */
+	static constexpr int32 MaxOffloadRestarts = 3;
 };
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Engine/EngineTypes.h"
+#include "FathomAuditSettings.generated.h"
+
+/**
+ * Per-user editor settings for the Fathom audit subsystem.
+ * Shown under Editor Preferences > Plugins > Fathom Audit.
+ */
+UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "Fathom Audit"))
+class FATHOMUELINK_API UFathomAuditSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UFathomAuditSettings();
+
+	/**
+	 * When the startup stale check finds a large number of stale assets (first run,
+	 * audit schema bump), re-audit them in a background UnrealEditor-Cmd process
+	 * instead of a modal progress dialog. The editor stays interactive; progress is
+	 * shown in a notification.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Stale Check", meta = (DisplayName = "Offload Bulk Re-Audit To Background Process"))
+	bool bOffloadBulkReAudit = false;
+
+	/**
+	 * Threads in Fathom's dedicated background pool (hashing, serialization, file
+	 * writes). They run at the lowest OS priority, separate from the engine's shared
+	 * pool, so shader and asset compiles keep their threads during a bulk audit.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (DisplayName = "Background Threads", ClampMin = "1", ClampMax = "16", ConfigRestartRequired = true))
+	int32 AuditThreadCount = 2;
+
+	/**
+	 * Pace background audit work by user activity. Once the editor has had no input
+	 * for Idle Threshold seconds (or is in the background), stale re-audits run at full
+	 * rate; while you are interacting they drop to a trickle, or pause entirely with
+	 * Pause While Active. A large re-audit waits for idle before opening its dialog.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (DisplayName = "Idle-Aware Scheduling"))
+	bool bIdleAwareScheduling = true;
+
+	/** Seconds without keyboard or mouse input before the editor counts as idle. */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (EditCondition = "bIdleAwareScheduling", ClampMin = "0.5", UIMin = "0.5", UIMax = "60", Units = "s"))
+	float IdleThresholdSeconds = 5.0f;
+
+	/** While you are interacting, pause background audit work instead of trickling it. */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (EditCondition = "bIdleAwareScheduling"))
+	bool bPauseWhileActive = false;
+
+	/**
+	 * Also keep every audit in one packed file (audit.pack plus a sorted index) next to
+	 * the per-asset .md files. Readers that fetch many audits (the /audit/read endpoint,
+	 * Fathom in Rider) map the pack once instead of opening thousands of small files.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Storage", meta = (DisplayName = "Packed Audit Store", ConfigRestartRequired = true))
+	bool bPackedAuditStore = false;
+
+	/**
+	 * Store audit files gzip-compressed as <Path>.md.gz. Large DataTable and level
+	 * Blueprint audits shrink several-fold, cutting disk use and sweep write bandwidth.
+	 * Fathom's HTTP endpoints decompress transparently (or pass the gzip through);
+	 * tools that read the audit tree directly must handle .md.gz. Existing .md files
+	 * are still read and are converted as they are rewritten.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Storage", meta = (DisplayName = "Compress Audit Files", ConfigRestartRequired = true))
+	bool bCompressAuditFiles = false;
+
+	/**
+	 * Also write the gathered audit data as Compact Binary (<Path>.ucb) next to each
+	 * audit, so tools can load node and edge graphs without parsing Markdown. Covers
+	 * Blueprints, Control Rigs, Materials, Behavior Trees, DataTables, DataAssets and
+	 * structs; sidecars appear as assets are re-audited.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Storage", meta = (DisplayName = "Write Compact Binary Sidecars", ConfigRestartRequired = true))
+	bool bWriteCompactBinarySidecars = false;
+
+	/**
+	 * Shared audit cache: a folder (local or a network share) of finished audits keyed
+	 * by .uasset hash and auditor version. Before loading a stale asset, Fathom copies
+	 * its audit from here when someone (typically CI) already audited identical bytes.
+	 * Relative paths are resolved against the project directory. Empty disables it;
+	 * -AuditCache=<Dir> overrides it.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Shared Cache", meta = (DisplayName = "Shared Audit Cache Directory", ConfigRestartRequired = true))
+	FDirectoryPath SharedAuditCacheDirectory;
+
+	/**
+	 * Add every audit written on this machine to the shared cache. Usually only CI
+	 * publishes (-PublishAuditCache); developers just read.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Shared Cache", meta = (DisplayName = "Publish To Shared Cache", ConfigRestartRequired = true))
+	bool bPublishToSharedAuditCache = false;
+};
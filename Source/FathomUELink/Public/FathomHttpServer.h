@@ -55,6 +55,12 @@ private:
 	bool HandleLiveCodingStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 	bool HandleLiveCodingCompile(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 
+	// -- Audit handlers --
+	bool HandleAuditStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleAuditRead(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleAuditFile(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleAuditSection(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
 	int32 BoundPort = 0;
 	TSharedPtr<IHttpRouter> HttpRouter;
 	TArray<FHttpRouteHandle> RouteHandles;
@@ -8,8 +8,6 @@
 #include "BlueprintAuditSubsystem.h"
 #include "FathomUELinkModule.h"
 
-static constexpr int32 GCInterval = 50;
-
 namespace
 {
 	/** Gather on the game thread and build a background serialize+write task for a PCG graph or graph instance. */
@@ -24,7 +22,7 @@ namespace
 			Task.Execute = [MovedData = MoveTemp(Data)]()
 			{
 				const FString Markdown = FPCGGraphAuditor::SerializeToMarkdown(MovedData);
-				FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
+				return FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
 			};
 			return Task;
 		}
@@ -38,7 +36,7 @@ namespace
 			Task.Execute = [MovedData = MoveTemp(Data)]()
 			{
 				const FString Markdown = FPCGGraphAuditor::SerializeInstanceToMarkdown(MovedData);
-				FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
+				return FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
 			};
 			return Task;
 		}
@@ -46,22 +44,6 @@ namespace
 		return {};
 	}
 
-	/** Synchronous gather + write, used by the commandlet batch path. */
-	bool AuditPCGAssetSynchronously(UObject* Object)
-	{
-		if (const UPCGGraph* Graph = Cast<UPCGGraph>(Object))
-		{
-			const FPCGGraphAuditData Data = FPCGGraphAuditor::GatherData(Graph);
-			return FAuditFileUtils::WriteAuditFile(FPCGGraphAuditor::SerializeToMarkdown(Data), Data.OutputPath);
-		}
-		if (const UPCGGraphInstance* Instance = Cast<UPCGGraphInstance>(Object))
-		{
-			const FPCGGraphInstanceAuditData Data = FPCGGraphAuditor::GatherInstanceData(Instance);
-			return FAuditFileUtils::WriteAuditFile(FPCGGraphAuditor::SerializeInstanceToMarkdown(Data), Data.OutputPath);
-		}
-		return false;
-	}
-
 	void GetAllPCGAssets(IAssetRegistry& AssetRegistry, TArray<FAssetData>& OutAssets)
 	{
 		const UClass* PCGClasses[] = { UPCGGraph::StaticClass(), UPCGGraphInstance::StaticClass() };
@@ -80,48 +62,8 @@ void FFathomUELinkPCGModule::StartupModule()
 
 	FAuditExtensionRegistry::FExtension Ext;
 	Ext.Name = TEXT("PCG");
-
-	// --- BatchAudit: commandlet batch scan ---
-	Ext.BatchAudit = [](IAssetRegistry& AssetRegistry, int32& OutSuccess, int32& OutFail, int32& OutSkip)
-	{
-		TArray<FAssetData> AllPCGAssets;
-		GetAllPCGAssets(AssetRegistry, AllPCGAssets);
-
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d PCG asset(s)..."), AllPCGAssets.Num());
-
-		int32 AssetsSinceGC = 0;
-		for (const FAssetData& Asset : AllPCGAssets)
-		{
-			if (!Asset.PackageName.ToString().StartsWith(TEXT("/Game/")))
-			{
-				++OutSkip;
-				continue;
-			}
-
-			UObject* Loaded = Asset.GetAsset();
-			if (!Loaded)
-			{
-				++OutFail;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load PCG asset %s"), *Asset.PackageName.ToString());
-				continue;
-			}
-
-			if (AuditPCGAssetSynchronously(Loaded))
-			{
-				++OutSuccess;
-			}
-			else
-			{
-				++OutFail;
-			}
-
-			if (++AssetsSinceGC >= GCInterval)
-			{
-				CollectGarbage(RF_NoFlags);
-				AssetsSinceGC = 0;
-			}
-		}
-	};
+	Ext.AssetType = EAuditAssetType::PCG;
+	Ext.SchemaVersion = FPCGGraphAuditor::SchemaVersion;
 
 	// --- TryAuditSavedObject: on-save handler ---
 	Ext.TryAuditSavedObject = [](UObject* Object) -> TOptional<FAuditWriteTask>
@@ -335,6 +335,7 @@ void SerializeSourceAndHash(FString& Out, const FString& SourceFilePath)
 		Out += FString::Printf(TEXT("SourcePath: %s\n"), *FAuditFileUtils::ToProjectRelativeSourcePath(SourceFilePath));
 	}
 	Out += FString::Printf(TEXT("Hash: %s\n"), *FAuditFileUtils::ComputeFileHash(SourceFilePath));
+	Out += FString::Printf(TEXT("AuditSchema: PCG/%d\n"), FPCGGraphAuditor::SchemaVersion);
 }
 
 void SerializeParameterTable(FString& Out, const TArray<FPCGGraphParamData>& Parameters, bool bWithOverrideColumn)
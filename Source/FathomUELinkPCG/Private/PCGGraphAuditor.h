@@ -15,6 +15,9 @@ class UPCGGraphInstance;
  */
 struct FPCGGraphAuditor
 {
+	/** Version of the PCG audit Markdown (graphs and instances). Bump it on a format change to re-audit only PCG assets. */
+	static constexpr int32 SchemaVersion = 1;
+
 	/** Gather all audit data from a PCG graph into a POD struct. Must be called on the game thread. */
 	static FPCGGraphAuditData GatherData(const UPCGGraph* Graph);
 
@@ -8,58 +8,14 @@
 #include "BlueprintAuditSubsystem.h"
 #include "FathomUELinkModule.h"
 
-static constexpr int32 GCInterval = 50;
-
 void FFathomUELinkStateTreeModule::StartupModule()
 {
 	UE_LOG(LogFathomUELink, Log, TEXT("Fathom: FathomUELinkStateTree module loaded, registering StateTree auditor."));
 
 	FAuditExtensionRegistry::FExtension Ext;
 	Ext.Name = TEXT("StateTree");
-
-	// --- BatchAudit: commandlet batch scan ---
-	Ext.BatchAudit = [](IAssetRegistry& AssetRegistry, int32& OutSuccess, int32& OutFail, int32& OutSkip)
-	{
-		TArray<FAssetData> AllStateTrees;
-		AssetRegistry.GetAssetsByClass(UStateTree::StaticClass()->GetClassPathName(), AllStateTrees, false);
-
-		UE_LOG(LogFathomUELink, Display, TEXT("Fathom: Auditing %d StateTree(s)..."), AllStateTrees.Num());
-
-		int32 AssetsSinceGC = 0;
-		for (const FAssetData& Asset : AllStateTrees)
-		{
-			if (!Asset.PackageName.ToString().StartsWith(TEXT("/Game/")))
-			{
-				++OutSkip;
-				continue;
-			}
-
-			const UStateTree* ST = Cast<UStateTree>(Asset.GetAsset());
-			if (!ST)
-			{
-				++OutFail;
-				UE_LOG(LogFathomUELink, Warning, TEXT("Fathom: Failed to load StateTree %s"), *Asset.PackageName.ToString());
-				continue;
-			}
-
-			FStateTreeAuditData Data = FStateTreeAuditor::GatherData(ST);
-			const FString Markdown = FStateTreeAuditor::SerializeToMarkdown(Data);
-			if (FAuditFileUtils::WriteAuditFile(Markdown, Data.OutputPath))
-			{
-				++OutSuccess;
-			}
-			else
-			{
-				++OutFail;
-			}
-
-			if (++AssetsSinceGC >= GCInterval)
-			{
-				CollectGarbage(RF_NoFlags);
-				AssetsSinceGC = 0;
-			}
-		}
-	};
+	Ext.AssetType = EAuditAssetType::StateTree;
+	Ext.SchemaVersion = FStateTreeAuditor::SchemaVersion;
 
 	// --- TryAuditSavedObject: on-save handler ---
 	Ext.TryAuditSavedObject = [](UObject* Object) -> TOptional<FAuditWriteTask>
@@ -78,7 +34,7 @@ void FFathomUELinkStateTreeModule::StartupModule()
 		Task.Execute = [MovedData = MoveTemp(Data)]()
 		{
 			const FString Markdown = FStateTreeAuditor::SerializeToMarkdown(MovedData);
-			FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
+			return FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
 		};
 
 		return Task;
@@ -130,7 +86,7 @@ void FFathomUELinkStateTreeModule::StartupModule()
 		Task.Execute = [MovedData = MoveTemp(Data)]()
 		{
 			const FString Markdown = FStateTreeAuditor::SerializeToMarkdown(MovedData);
-			FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
+			return FAuditFileUtils::WriteAuditFile(Markdown, MovedData.OutputPath);
 		};
 
 		return Task;
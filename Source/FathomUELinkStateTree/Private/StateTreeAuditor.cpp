@@ -1033,6 +1033,7 @@ FString FStateTreeAuditor::SerializeToMarkdown(const FStateTreeAuditData& Data)
 	}
 	const FString Hash = FAuditFileUtils::ComputeFileHash(Data.SourceFilePath);
 	Out += FString::Printf(TEXT("Hash: %s\n"), *Hash);
+	Out += FString::Printf(TEXT("AuditSchema: StateTree/%d\n"), FStateTreeAuditor::SchemaVersion);
 
 	if (!Data.SchemaName.IsEmpty())
 	{
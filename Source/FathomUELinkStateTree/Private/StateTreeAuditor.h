@@ -12,6 +12,9 @@ class UStateTree;
  */
 struct FStateTreeAuditor
 {
+	/** Version of the StateTree audit Markdown. Bump it on a format change to re-audit only StateTrees. */
+	static constexpr int32 SchemaVersion = 1;
+
 	/** Gather all audit data from a StateTree into a POD struct. Must be called on the game thread. */
 	static FStateTreeAuditData GatherData(const UStateTree* ST);
 